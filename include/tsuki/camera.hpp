@@ -0,0 +1,44 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <cstdint>
+#include <utility>
+
+namespace tsuki {
+
+// View into the world: the position is the world point shown at the centre of
+// the viewport. Graphics applies the active camera beneath every transform and
+// culls draws that land outside its view.
+class Camera {
+public:
+    Camera() = default;
+
+    void setPosition(float x, float y);
+    std::pair<float, float> getPosition() const { return {x_, y_}; }
+    void move(float dx, float dy);
+
+    void setZoom(float zoom);
+    float getZoom() const { return zoom_; }
+
+    void setRotation(float rotation);
+    float getRotation() const { return rotation_; }
+
+    // Viewport in render target pixels; without one the camera covers the whole target
+    void setViewport(int x, int y, int width, int height);
+    void clearViewport();
+    bool hasViewport() const { return has_viewport_; }
+    SDL_Rect getViewport() const { return viewport_; }
+
+    // Bumped on every change so Graphics knows when to rebuild its view transform
+    uint32_t getRevision() const { return revision_; }
+
+private:
+    float x_ = 0.0f, y_ = 0.0f;
+    float zoom_ = 1.0f;
+    float rotation_ = 0.0f;
+    SDL_Rect viewport_ = {0, 0, 0, 0};
+    bool has_viewport_ = false;
+    uint32_t revision_ = 1;
+};
+
+} // namespace tsuki
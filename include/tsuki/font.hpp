@@ -4,9 +4,25 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <unordered_map>
+#include <cstdint>
 
 namespace tsuki {
 
+// A rasterized glyph living in one of the font's atlas pages
+struct Glyph {
+    SDL_Texture* texture = nullptr;  // Atlas page, nullptr for blank glyphs such as space
+    float x0 = 0.0f, y0 = 0.0f;      // Quad offset from the pen position on the baseline
+    float x1 = 0.0f, y1 = 0.0f;
+    float u0 = 0.0f, v0 = 0.0f;      // Normalized texture coordinates in the page
+    float u1 = 0.0f, v1 = 0.0f;
+    float advance = 0.0f;
+};
+
+// Decodes the UTF-8 sequence at text[*index] and moves *index past it. Malformed or
+// truncated sequences yield U+FFFD and skip a single byte.
+uint32_t decodeUtf8(const std::string& text, size_t* index);
+
 class Font {
 public:
     Font();
@@ -18,29 +34,118 @@ public:
     Font(Font&& other) noexcept;
     Font& operator=(Font&& other) noexcept;
 
-    // Load font from file or memory
-    bool loadFromFile(const std::string& filename, float size = 16.0f);
-    bool loadFromMemory(const unsigned char* data, size_t size, float fontSize = 16.0f);
+    // Load font from file or memory. SDF fonts rasterize signed distance fields at a fixed
+    // reference size and scale them to the requested size, so they stay smooth when zoomed.
+    bool loadFromFile(const std::string& filename, float size = 16.0f, bool sdf = false);
+    bool loadFromMemory(const unsigned char* data, size_t size, float fontSize = 16.0f, bool sdf = false);
+    // Same face at another size, sharing its font bytes; SDF fonts also share the distance-field atlas
+    bool loadFromFont(const Font& face, float size);
 
     // Get font properties
     float getSize() const { return size_; }
-    bool isLoaded() const { return !fontData_.empty() && stbFont_ != nullptr; }
+    bool isLoaded() const { return fontData_ && stbFont_ != nullptr; }
+    bool isSDF() const { return sdf_ != nullptr; }
+    const std::string& getSource() const { return source_; } // File name, empty for memory fonts
 
     // Text measurement
     void getTextSize(const std::string& text, int* width, int* height) const;
+    float getAscent() const { return ascent_; }
+    float getLineHeight() const { return lineHeight_; } // Baseline to baseline, including line gap
+    float getKerning(uint32_t first, uint32_t second) const;
+
+    // Cached glyph lookup; rasterizes into the atlas on first use. Codepoints this font
+    // lacks come from the first fallback that has them.
+    const Glyph* getGlyph(SDL_Renderer* renderer, uint32_t codepoint);
+
+    // Font-local glyph index, 0 when the font has no glyph for the codepoint. Lookups are
+    // cached in a dense table for the Basic Multilingual Plane and a hash map above it.
+    int getGlyphIndex(uint32_t codepoint) const;
+    bool hasGlyph(uint32_t codepoint) const { return getGlyphIndex(codepoint) != 0; }
+
+    // Atlas pages this font draws glyphs from, including a shared SDF atlas
+    std::vector<SDL_Texture*> getAtlasTextures() const;
+
+    // Fonts tried in order for missing codepoints; they must stay alive until replaced
+    void setFallbacks(std::vector<Font*> fallbacks);
 
     // Render text to SDL texture
     SDL_Texture* renderText(SDL_Renderer* renderer, const std::string& text,
                            Uint8 r = 255, Uint8 g = 255, Uint8 b = 255, Uint8 a = 255) const;
 
 private:
-    std::vector<unsigned char> fontData_;
+    static constexpr int ATLAS_PAGE_SIZE = 512;
+    static constexpr int ATLAS_PADDING = 1;
+
+    // Glyphs are packed into rows (shelves) from top to bottom
+    struct AtlasPage {
+        SDL_Texture* texture = nullptr;
+        int width = 0;
+        int height = 0;
+        int cursorX = 0;
+        int cursorY = 0;
+        int rowHeight = 0;
+    };
+
+    // Distance-field glyphs at SDF_SIZE, keyed by glyph index and shared by every size of a face
+    static constexpr float SDF_SIZE = 48.0f;
+    static constexpr int SDF_PADDING = 4;
+    static constexpr unsigned char SDF_ON_EDGE = 128;
+    static constexpr float SDF_PIXEL_DIST_SCALE = 32.0f; // Field units per reference pixel
+    static constexpr float SDF_EDGE_WIDTH = 1.5f;        // Alpha ramp across the outline, reference pixels
+
+    struct SdfGlyph {
+        SDL_Texture* texture = nullptr;
+        float x0 = 0.0f, y0 = 0.0f, x1 = 0.0f, y1 = 0.0f; // At SDF_SIZE
+        float u0 = 0.0f, v0 = 0.0f, u1 = 0.0f, v1 = 0.0f;
+    };
+
+    struct SdfAtlas {
+        std::vector<AtlasPage> pages;
+        std::unordered_map<int, SdfGlyph> glyphs;
+        ~SdfAtlas();
+    };
+
+    std::shared_ptr<const std::vector<unsigned char>> fontData_; // Shared by every size of a face
+    std::string source_;
     void* stbFont_; // stbtt_fontinfo*
     float size_;
     float scale_;
+    float ascent_;
+    float lineHeight_;
+    float descent_ = 0.0f; // Below the baseline, negative
+
+    // Advances and kerning for printable ASCII, filled on load so measuring common text is
+    // table reads. Advances of glyphs this font lacks are negative and take the slow path.
+    static constexpr uint32_t METRICS_TABLE_FIRST = 0x20;
+    static constexpr uint32_t METRICS_TABLE_SIZE = 0x7F - METRICS_TABLE_FIRST;
+    std::vector<float> advanceTable_;
+    std::vector<float> kerningTable_; // [first * METRICS_TABLE_SIZE + second]
+
+    std::unordered_map<uint32_t, Glyph> glyphs_;
+    std::vector<AtlasPage> atlasPages_;
+
+    std::shared_ptr<SdfAtlas> sdf_; // Null for bitmap fonts
+    float sdfScale_ = 0.0f;         // stbtt scale of the reference size
+
+    static constexpr uint32_t DENSE_GLYPH_RANGE = 0x10000;
+    mutable std::vector<int> glyphIndexDense_; // -1 until looked up
+    mutable std::unordered_map<uint32_t, int> glyphIndexSparse_;
+
+    std::vector<Font*> fallbacks_;
+    std::unordered_map<uint32_t, const Glyph*> fallbackGlyphs_; // Owned by the fallback fonts
+
+    const Font* fontFor(uint32_t codepoint) const; // This font or the fallback providing codepoint
+    float getAdvance(uint32_t codepoint) const;
 
     void cleanup();
     bool initializeFont();
+    void buildMetricsTables();
+    void releaseAtlas();
+    Glyph rasterizeGlyph(SDL_Renderer* renderer, uint32_t codepoint);
+    Glyph rasterizeSDFGlyph(SDL_Renderer* renderer, uint32_t codepoint);
+    SdfGlyph bakeSDFGlyph(SDL_Renderer* renderer, int index);
+    static AtlasPage* allocateAtlasRect(SDL_Renderer* renderer, std::vector<AtlasPage>& pages,
+                                        int width, int height, int* x, int* y);
 };
 
 } // namespace tsuki
\ No newline at end of file
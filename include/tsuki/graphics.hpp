@@ -6,20 +6,38 @@
 #include <array>
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <cstdint>
 
 #ifdef TSUKI_HAS_SDL_IMAGE
 #include <SDL3_image/SDL_image.h>
 #endif
 
 #include "font.hpp"
+#include "image_decoder.hpp"
+#include "texture_atlas.hpp"
 
 namespace tsuki {
 
+class Camera;
+class Graphics;
+class Mesh;
+class ParticleSystem;
+class Shape;
+class SpriteBatch;
+class Tilemap;
+
 enum class DrawMode {
     Fill,
     Line
 };
 
+enum class LineJoin {
+    Miter,
+    Bevel,
+    None
+};
+
 enum class HorizontalAlign {
     Left,
     Center,
@@ -45,6 +63,23 @@ struct Color {
     static Color blue() { return {0.0f, 0.0f, 1.0f, 1.0f}; }
 };
 
+// Quad corners relative to the top-left of a requested region, plus the
+// texture coordinates that cover them
+struct TextureQuad {
+    float x0, y0, x1, y1;
+    float u0, v0, u1, v1;
+};
+
+// Generation-checked reference to an image owned by Graphics. A handle whose
+// image has been unloaded (or replaced) simply stops resolving.
+struct ImageHandle {
+    uint32_t index = 0;
+    uint32_t generation = 0; // 0 never names a live image
+
+    bool isValid() const { return generation != 0; }
+    explicit operator bool() const { return isValid(); }
+};
+
 class Image {
 public:
     Image() = default;
@@ -56,19 +91,136 @@ public:
     Image(Image&& other) noexcept;
     Image& operator=(Image&& other) noexcept;
 
-    bool load(const std::string& filename, SDL_Renderer* renderer);
+    // With an atlas, small images are trimmed and packed into a shared page
+    bool load(const std::string& filename, SDL_Renderer* renderer, TextureAtlas* atlas = nullptr);
+    // Uploads already decoded RGBA32 pixels (tightly packed)
+    bool loadPixels(const unsigned char* pixels, int width, int height, SDL_Renderer* renderer,
+                    TextureAtlas* atlas = nullptr);
     void unload();
 
     int getWidth() const;
     int getHeight() const;
     bool isValid() const { return texture_ != nullptr; }
+    bool isAtlased() const { return atlas_ != nullptr; }
 
     SDL_Texture* getTexture() const { return texture_; }
 
+    // Maps a rect in image pixels onto the texture; false if it only covers trimmed-away space
+    bool mapRegion(const SDL_FRect& region, TextureQuad* quad) const;
+
+    // Residency: a standalone texture loaded from a file can be dropped and later restored
+    // from pixels decoded from that file. Size and texture coordinates are kept meanwhile.
+    bool evict();
+    bool restore(const unsigned char* pixels, int width, int height, SDL_Renderer* renderer);
+    bool isEvicted() const { return evicted_; }
+    const std::string& getSource() const { return source_; }
+    size_t getTextureBytes() const; // Atlas pages are accounted separately, only a standalone copy counts
+
 private:
+    friend class Graphics;
+
     SDL_Texture* texture_ = nullptr;
     int width_ = 0;
     int height_ = 0;
+
+    // Part of the image that has texels, in image pixels, and its normalized
+    // texture coordinates (x, y = top-left, w, h = bottom-right)
+    SDL_FRect bounds_ = {0.0f, 0.0f, 0.0f, 0.0f};
+    SDL_FRect tex_coords_ = {0.0f, 0.0f, 1.0f, 1.0f};
+
+    TextureAtlas* atlas_ = nullptr;
+    int atlas_page_ = -1;
+    SDL_Texture* standalone_ = nullptr; // Whole-image copy of an atlased image, made for meshes
+
+    std::string source_;
+    bool evicted_ = false;
+    uint32_t slot_ = UINT32_MAX; // Index into Graphics' image slots when owned there
+
+    static SDL_Rect findOpaqueBounds(const unsigned char* pixels, int width, int height);
+};
+
+// Offscreen render target that can be drawn like an Image
+class Canvas {
+public:
+    Canvas() = default;
+    Canvas(int width, int height, SDL_Renderer* renderer);
+    ~Canvas();
+
+    Canvas(const Canvas&) = delete;
+    Canvas& operator=(const Canvas&) = delete;
+    Canvas(Canvas&& other) noexcept;
+    Canvas& operator=(Canvas&& other) noexcept;
+
+    bool create(SDL_Renderer* renderer, int width, int height);
+    void release();
+
+    int getWidth() const { return width_; }
+    int getHeight() const { return height_; }
+    bool isValid() const { return texture_ != nullptr; }
+
+    SDL_Texture* getTexture() const { return texture_; }
+
+private:
+    friend class Graphics;
+
+    SDL_Texture* texture_ = nullptr;
+    int width_ = 0;
+    int height_ = 0;
+    Graphics* graphics_ = nullptr; // Notified before the texture is destroyed, see Graphics::newCanvas
+};
+
+// Result of Graphics::loadImageAsync; filled in on the main thread once the image is uploaded
+class ImageLoad {
+public:
+    enum class State {
+        Pending,
+        Ready,
+        Failed
+    };
+
+    State getState() const { return state_; }
+    bool isDone() const { return state_ != State::Pending; }
+    ImageHandle getImage() const { return image_; }
+    const std::string& getName() const { return name_; }
+
+private:
+    friend class Graphics;
+
+    std::string name_;
+    std::string filename_; // Kept as the image's source so it can be evicted and reloaded
+    State state_ = State::Pending;
+    ImageHandle image_;
+};
+
+struct ImageLoadProgress {
+    int total = 0;     // Requests since the queue was last empty
+    int completed = 0; // Includes failed ones
+    int failed = 0;
+    float fraction = 1.0f;
+};
+
+struct TextureStats {
+    size_t residentBytes = 0;
+    size_t budgetBytes = 0; // 0 = unlimited
+    int residentImages = 0;
+    int evictedImages = 0;
+    int evictions = 0;
+    int reloads = 0;
+};
+
+struct RenderStateStats {
+    int issued = 0;
+    int skipped = 0;
+};
+
+struct CullStats {
+    int culled = 0; // Draws rejected before any vertices were built
+};
+
+struct DrawQueueStats {
+    int items = 0;        // Runs of deferred geometry queued
+    int batches = 0;      // Geometry submissions after sorting
+    int batchesSaved = 0; // Submissions the sort avoided compared to drawing order
 };
 
 class Graphics {
@@ -87,34 +239,129 @@ public:
     void setColor(const Color& color);
     Color getColor() const { return current_color_; }
 
+    // Width applies to every outline and is scaled with the transform. At exactly 1 lines
+    // use SDL's one-pixel line renderer; any other width is tessellated into the batch.
+    void setLineWidth(float width);
+    float getLineWidth() const { return line_width_; }
+    void setLineJoin(LineJoin join) { line_join_ = join; }
+    LineJoin getLineJoin() const { return line_join_; }
+
+    // Scissor in render target pixels; the no-argument form disables it
+    void setScissor(int x, int y, int width, int height);
+    void setScissor();
+    bool getScissor(SDL_Rect* rect) const;
+
+    // Draw color, clip rect, render target and viewport changes sent to SDL versus dropped as
+    // redundant, for the last presented frame. Textures are bound by each geometry call.
+    RenderStateStats getRenderStateStats() const { return last_frame_state_stats_; }
+
+    // Deferred mode: geometry is queued with the current layer and depth, then sorted by
+    // (layer, depth) and submitted at present(). Lower layers and depths draw first and draws
+    // left at layer 0, depth 0 keep drawing order. Draws sharing any other (layer, depth) are
+    // treated as order-independent and grouped by texture. Canvas and scissor changes submit
+    // the queue early, as do a full batch and text drawn with the debug font.
+    void setDeferred(bool deferred);
+    bool isDeferred() const { return deferred_; }
+    void setLayer(int layer) { draw_layer_ = layer; }
+    int getLayer() const { return draw_layer_; }
+    void setDepth(float depth) { draw_depth_ = depth; }
+    float getDepth() const { return draw_depth_; }
+    DrawQueueStats getDrawQueueStats() const { return last_frame_queue_stats_; }
+
+    SDL_Renderer* getRenderer() const { return renderer_; }
+
+    // Reusable buffer for bindings converting script arrays; valid until the next conversion
+    std::vector<float>& getScratchFloats() { return scratch_floats_; }
+
     // Drawing functions (similar to LOVE API)
     void rectangle(DrawMode mode, float x, float y, float width, float height);
-    void circle(DrawMode mode, float x, float y, float radius, int segments = 32);
-    void ellipse(DrawMode mode, float x, float y, float rx, float ry, int segments = 32);
+    // A segment count of 0 picks one from the on-screen radius; explicit counts are used as given
+    void circle(DrawMode mode, float x, float y, float radius, int segments = 0);
+    void ellipse(DrawMode mode, float x, float y, float rx, float ry, int segments = 0);
     void line(float x1, float y1, float x2, float y2);
     void polygon(DrawMode mode, const std::vector<float>& points);
-    void arc(DrawMode mode, float x, float y, float radius, float angle1, float angle2, int segments = 32);
+    void polygon(DrawMode mode, const Shape& shape); // Concave, with holes; triangulation is cached
+    void arc(DrawMode mode, float x, float y, float radius, float angle1, float angle2, int segments = 0);
     void point(float x, float y);
     void points(const std::vector<float>& points);
 
+    // Bulk variants over flat float arrays, each drawn with one SDL call.
+    // Counts are in elements: points (x, y), rectangles (x, y, w, h), triangles (3 x, y pairs).
+    void points(const float* coords, size_t count);
+    void lines(const float* coords, size_t count); // Connected polyline through count points
+    // Like lines, but always tessellated with the line width and join, even at width 1, so a
+    // path of any length is one batched submission
+    void polyline(const float* coords, size_t count);
+    void rectangles(DrawMode mode, const float* rects, size_t count);
+    void triangles(const float* coords, size_t count);
+
     // Image drawing
     void draw(const Image& image, float x, float y);
     void draw(const Image& image, float x, float y, float rotation, float sx = 1.0f, float sy = 1.0f,
               float ox = 0.0f, float oy = 0.0f);
+    void draw(ImageHandle handle, float x, float y);
+    void draw(ImageHandle handle, float x, float y, float rotation, float sx = 1.0f, float sy = 1.0f,
+              float ox = 0.0f, float oy = 0.0f);
+    // Name lookups, kept for compatibility; prefer handles in hot paths
     void draw(const std::string& imageName, float x, float y);
     void draw(const std::string& imageName, float x, float y, float rotation, float sx = 1.0f, float sy = 1.0f,
               float ox = 0.0f, float oy = 0.0f);
+    void draw(const Canvas& canvas, float x, float y);
+    void draw(const Canvas& canvas, float x, float y, float rotation, float sx = 1.0f, float sy = 1.0f,
+              float ox = 0.0f, float oy = 0.0f);
+    void draw(SpriteBatch& batch, float x = 0.0f, float y = 0.0f);
+    void draw(const Mesh& mesh, float x = 0.0f, float y = 0.0f);
+    void draw(Tilemap& tilemap, float x = 0.0f, float y = 0.0f, int layer = -1); // layer -1 draws all
+    void draw(ParticleSystem& particles, float x = 0.0f, float y = 0.0f);
+
+    // Canvas owned by the caller that unbinds itself and flushes queued draws using it when destroyed
+    std::unique_ptr<Canvas> newCanvas(int width, int height);
+
+    // Render targets; nullptr draws to the screen again
+    void setCanvas(Canvas* canvas);
+    Canvas* getCanvas() const { return current_canvas_; }
+
+    // Pooled canvases for transient effects, reused by size once released
+    Canvas* acquireCanvas(int width, int height);
+    void releaseCanvas(Canvas* canvas);
 
     // Font management
-    bool loadFont(const std::string& name, const std::string& filename, float size = 16.0f);
+    // SDF fonts loaded from the same file share one distance-field atlas across all sizes
+    bool loadFont(const std::string& name, const std::string& filename, float size = 16.0f, bool sdf = false);
     bool setFont(const std::string& name);
+    // Fonts (by name) tried in order for characters the named font lacks; kept across reloads
+    bool setFontFallbacks(const std::string& name, const std::vector<std::string>& fallbacks);
     void setDefaultFont();
     bool initializeDefaultFont();
 
-    // Image management
-    bool loadImage(const std::string& name, const std::string& filename);
+    // Image management. Loading under an existing name replaces that image and
+    // invalidates handles to the old one.
+    ImageHandle loadImage(const std::string& name, const std::string& filename);
     bool unloadImage(const std::string& name);
+    bool unloadImage(ImageHandle handle);
     Image* getImage(const std::string& name);
+    Image* getImage(ImageHandle handle) {
+        if (handle.index >= image_slots_.size() || image_slots_[handle.index].generation != handle.generation) {
+            return nullptr;
+        }
+        return image_slots_[handle.index].image.get();
+    }
+    ImageHandle findImage(const std::string& name) const;
+    std::vector<TextureAtlas::PageStats> getAtlasStats() const { return image_atlas_.getStats(); }
+
+    // Decodes on worker threads; finished images are uploaded at present() within the upload budget
+    std::shared_ptr<ImageLoad> loadImageAsync(const std::string& name, const std::string& filename);
+    void setImageUploadBudget(float milliseconds);
+    float getImageUploadBudget() const { return upload_budget_ms_; }
+    ImageLoadProgress getImageLoadProgress() const;
+
+    // With a budget, standalone image textures not drawn recently are evicted at present()
+    // until the estimated texture memory fits. Drawing an evicted image queues its file on
+    // the decoder and skips the draw until the reload is uploaded. Atlased images are never
+    // evicted, and their pages count as resident.
+    void setTextureBudget(size_t bytes) { texture_budget_ = bytes; }
+    size_t getTextureBudget() const { return texture_budget_; }
+    TextureStats getTextureStats() const;
 
     // Text drawing
     void print(const std::string& text, float x, float y);
@@ -125,6 +372,8 @@ public:
                      HorizontalAlign halign = HorizontalAlign::Left, VerticalAlign valign = VerticalAlign::Top);
     void printAligned(const std::string& text, float x, float y, float width, float height, const std::string& align);
     std::pair<int, int> getTextSize(const std::string& text);
+    // Word-wraps at limit and aligns each line ("left", "center", "right" or "justify"). Line
+    // breaks and glyph placement are cached per (font, text, limit, align).
     void printf(const std::string& text, float x, float y, float limit, const std::string& align = "left");
 
     // Transformation
@@ -133,6 +382,31 @@ public:
     void translate(float x, float y);
     void rotate(float angle);
     void scale(float sx, float sy);
+    void origin();
+    // Both include the active camera, so inverseTransformPoint maps screen to world
+    std::pair<float, float> transformPoint(float x, float y);
+    std::pair<float, float> inverseTransformPoint(float x, float y);
+
+    // Camera applied beneath all transforms; nullptr restores the plain screen view.
+    // The camera must outlive its use here (the Lua binding keeps the active one referenced).
+    // Changes to it are picked up on the next draw.
+    void setCamera(const Camera* camera);
+    const Camera* getCamera() const { return camera_; }
+    CullStats getCullStats() const { return last_frame_cull_stats_; }
+
+    // Logical resolution: the screen is drawn into an internal canvas of this size (times the
+    // render scale) and scaled to fit the window at present(). 0x0 uses the window size.
+    void setLogicalSize(int width, int height, bool integerScale = false);
+    std::pair<int, int> getLogicalSize() const { return {logical_width_, logical_height_}; }
+    std::pair<float, float> toLogical(float x, float y) const; // Window pixels to logical units
+
+    // Internal resolution as a fraction of the logical size, applied from the next frame
+    void setRenderScale(float scale);
+    float getRenderScale() const { return render_scale_; }
+
+    // Adjusts the render scale each frame to keep the frame time within budget
+    void setDynamicResolution(bool enabled, float frameBudgetMs = 1000.0f / 60.0f, float minScale = 0.5f);
+    bool isDynamicResolution() const { return dynamic_resolution_; }
 
 private:
     SDL_Renderer* renderer_ = nullptr;
@@ -141,22 +415,296 @@ private:
     // Font management
     std::map<std::string, std::unique_ptr<Font>> fonts_;
     Font* current_font_ = nullptr;
+    std::map<std::string, std::vector<std::string>> font_fallbacks_;
+
+    void resolveFontFallbacks();
+
+    // Wrapped text layouts for printf, relative to the print position
+    enum class TextAlign {
+        Left,
+        Center,
+        Right,
+        Justify
+    };
+
+    struct TextLayoutKey {
+        const Font* font;
+        std::string text;
+        float limit;
+        TextAlign align;
+
+        bool operator==(const TextLayoutKey& other) const {
+            return font == other.font && limit == other.limit && align == other.align && text == other.text;
+        }
+    };
+
+    struct TextLayoutKeyHash {
+        size_t operator()(const TextLayoutKey& key) const {
+            size_t hash = std::hash<std::string>()(key.text);
+            hash ^= std::hash<const void*>()(key.font) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            hash ^= std::hash<float>()(key.limit) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            return hash ^ (static_cast<size_t>(key.align) << 1);
+        }
+    };
+
+    struct PlacedGlyph {
+        const Glyph* glyph;
+        float x, y; // Pen position on the baseline
+    };
+
+    struct TextLine {
+        size_t start, end; // Byte range, trailing spaces excluded
+        float x, y;        // Top-left of the line
+        float width;
+        int spaces;
+    };
+
+    struct TextLayout {
+        std::vector<TextLine> lines;
+        std::vector<PlacedGlyph> glyphs; // Only for TrueType fonts; the debug font prints lines
+        float height = 0.0f;
+        uint64_t lastUsedFrame = 0;
+    };
+
+    static constexpr size_t MAX_TEXT_LAYOUTS = 256;
+    std::unordered_map<TextLayoutKey, TextLayout, TextLayoutKeyHash> text_layouts_;
+
+    const TextLayout& layoutText(const std::string& text, float limit, TextAlign align);
+    float glyphAdvance(uint32_t codepoint, uint32_t next);
+
+    // Image management (the atlas is declared first so it outlives the images packed into it).
+    // Images live in a flat slot vector; a slot's generation changes whenever it is freed.
+    struct ImageSlot {
+        std::unique_ptr<Image> image;
+        std::string name;
+        uint32_t generation = 1;
+        uint64_t lastUsedFrame = 0;
+        bool restoring = false; // Evicted and queued on the decoder for reloading
+    };
+
+    TextureAtlas image_atlas_;
+    std::vector<ImageSlot> image_slots_;
+    std::vector<uint32_t> free_image_slots_;
+    std::unordered_map<std::string, ImageHandle> image_names_;
+
+    ImageHandle addImage(const std::string& name, std::unique_ptr<Image> image);
+
+    // Asynchronous loading
+    ImageDecoder image_decoder_;
+    std::unordered_map<uint64_t, std::shared_ptr<ImageLoad>> pending_loads_;
+    std::unordered_map<uint64_t, ImageHandle> pending_restores_; // Decodes of evicted images
+    uint64_t next_load_id_ = 1;
+    float upload_budget_ms_ = 4.0f;
+    int loads_total_ = 0;
+    int loads_completed_ = 0;
+    int loads_failed_ = 0;
+
+    void processImageLoads();
+    void cancelImageLoads();
+
+    // Texture residency
+    size_t texture_budget_ = 0;
+    uint64_t frame_index_ = 0;
+    int texture_evictions_ = 0;
+    int texture_reloads_ = 0;
+
+    bool useImage(const Image* image); // Marks an image drawn this frame, queueing a reload if evicted
+    SDL_Texture* standaloneTexture(Image& image); // The image alone in a texture, untrimmed
+    size_t residentTextureBytes() const;
+    void enforceTextureBudget();
+
+    // Canvas management
+    struct PooledCanvas {
+        std::unique_ptr<Canvas> canvas;
+        bool inUse = false;
+    };
 
-    // Image management
-    std::map<std::string, std::unique_ptr<Image>> images_;
+    Canvas* current_canvas_ = nullptr;
+    std::vector<PooledCanvas> canvas_pool_;
 
+    friend class Canvas;
+    void canvasReleased(Canvas* canvas);
+
+    // 2D affine transform as a 3x2 matrix:
+    // | a c tx |
+    // | b d ty |
     struct Transform {
+        float a = 1.0f, b = 0.0f;
+        float c = 0.0f, d = 1.0f;
         float tx = 0.0f, ty = 0.0f;
-        float rotation = 0.0f;
-        float sx = 1.0f, sy = 1.0f;
+
+        bool isIdentity() const {
+            return a == 1.0f && b == 0.0f && c == 0.0f && d == 1.0f && tx == 0.0f && ty == 0.0f;
+        }
     };
 
     std::vector<Transform> transform_stack_;
     Transform current_transform_;
-
-    void applyTransform();
+    Transform render_transform_; // view_transform_ * current_transform_, what vertices go through
+    bool transform_is_identity_ = true;
+
+    // Camera view: rebuilt lazily when the camera's revision or the render target changes
+    const Camera* camera_ = nullptr;
+    uint32_t camera_revision_ = 0;
+    bool view_dirty_ = true;
+    Transform view_transform_;
+    float view_width_ = 0.0f;  // Target size in the units render_transform_ maps into (scene canvas pixels
+    float view_height_ = 0.0f; // when drawing to a scaled-down scene)
+    mutable CullStats cull_stats_;
+    CullStats last_frame_cull_stats_;
+
+    void syncView();
+    bool isCulled(float x0, float y0, float x1, float y1) const;
+    bool isCulled(const SDL_FPoint* points, size_t count) const;
+
+    void transformChanged();
+    void transformVertices(SDL_Vertex* vertices, size_t count) const;
+    void transformPoints(SDL_FPoint* points, size_t count) const;
+    bool getVisibleBounds(float* x0, float* y0, float* x1, float* y1);
     void drawCirclePoints(float cx, float cy, float x, float y);
 
+    // Geometry batching: consecutive primitives that share a texture and blend
+    // mode are collected here and submitted with a single SDL_RenderGeometry.
+    static constexpr size_t MAX_BATCH_VERTICES = 65536;
+
+    std::vector<SDL_Vertex> batch_vertices_;
+    std::vector<int> batch_indices_;
+    SDL_Texture* batch_texture_ = nullptr;
+    SDL_BlendMode batch_blend_mode_ = SDL_BLENDMODE_NONE;
+
+    int reserveBatch(SDL_Texture* texture, size_t vertexCount, size_t indexCount);
+    void flushBatch();
+    void discardBatch();
+    void batchFan(float cx, float cy, float rx, float ry, float angle1, float angleRange, int segments);
+    void batchQuad(SDL_Texture* texture, const SDL_FPoint positions[4], const SDL_FPoint texCoords[4],
+                   const SDL_FColor& color);
+    void drawArcOutline(float cx, float cy, float rx, float ry, float angle1, float angleRange, int segments);
+    void drawLineStrip(const SDL_FPoint* points, size_t count);
+    void drawPoints(const SDL_FPoint* points, size_t count);
+    void drawTexture(SDL_Texture* texture, const TextureQuad& quad, float x, float y,
+                     float rotation, float sx, float sy, float ox, float oy);
+    void submitGeometry(SDL_Texture* texture, const SDL_Vertex* vertices, size_t vertexCount,
+                        const int* indices, size_t indexCount);
+
+    // Shape tessellation: unit-circle tables per segment count and a reusable point buffer
+    static constexpr int MIN_CIRCLE_SEGMENTS = 8;
+    static constexpr int MAX_CIRCLE_SEGMENTS = 256;
+
+    std::vector<std::vector<SDL_FPoint>> unit_circles_;
+    std::vector<SDL_FPoint> scratch_points_;
+    std::vector<SDL_FRect> scratch_rects_;
+    std::vector<float> scratch_floats_;
+
+    // Stroking: joins whose miter would be longer than MITER_LIMIT half-widths are beveled
+    static constexpr float MITER_LIMIT = 4.0f;
+
+    float line_width_ = 1.0f;
+    LineJoin line_join_ = LineJoin::Miter;
+    std::vector<SDL_FPoint> stroke_points_;
+
+    void strokeLineStrip(const SDL_FPoint* points, size_t count);
+    float strokeExtent(DrawMode mode) const; // How far an outline reaches past its path, in local units
+
+    SDL_FPoint* buildArcPoints(float cx, float cy, float rx, float ry, float angle1, float angleRange, int segments);
+    const std::vector<SDL_FPoint>& unitCircle(int segments);
+    int autoSegments(float radius) const;
+    const SDL_FPoint* loadScratchPoints(const float* coords, size_t count);
+
+    // Deferred draw queue: runs of batch geometry tagged with a sort key
+    struct DeferredItem {
+        uint64_t key;
+        uint32_t vertexStart;
+        uint32_t vertexCount;
+        uint32_t indexStart;
+        uint32_t indexCount;
+        SDL_Texture* texture;
+        SDL_BlendMode blendMode;
+    };
+
+    struct SortEntry {
+        uint64_t key;
+        uint32_t item;
+    };
+
+    bool deferred_ = false;
+    int draw_layer_ = 0;
+    float draw_depth_ = 0.0f;
+    std::vector<DeferredItem> deferred_items_;
+    std::vector<SortEntry> deferred_order_;
+    std::vector<SortEntry> deferred_sort_scratch_;
+    std::vector<SDL_Vertex> deferred_vertices_; // One sorted run at a time, compacted out of batch_vertices_
+    std::vector<int> deferred_indices_;
+    std::unordered_map<SDL_Texture*, uint16_t> deferred_texture_ids_;
+    DrawQueueStats queue_stats_;
+    DrawQueueStats last_frame_queue_stats_;
+
+    void queueDeferred(SDL_Texture* texture, SDL_BlendMode blendMode);
+    void sortDeferred();
+    void submitDeferred();
+
+    // Renderer state as last sent to SDL, so redundant changes can be skipped
+    struct RenderState {
+        SDL_Color draw_color = {0, 0, 0, 0};
+        bool draw_color_valid = false;
+        SDL_BlendMode blend_mode = SDL_BLENDMODE_NONE;
+        SDL_Texture* blend_texture = nullptr; // Texture whose blend mode is cached below
+        SDL_BlendMode texture_blend_mode = SDL_BLENDMODE_NONE;
+        SDL_Rect clip_rect = {0, 0, 0, 0};
+        bool clip_enabled = false;
+        bool clip_valid = false;
+        SDL_Texture* target = nullptr;
+        bool target_valid = false;
+        SDL_Rect viewport = {0, 0, 0, 0};
+        bool viewport_enabled = false;
+        bool viewport_valid = false;
+    };
+
+    RenderState render_state_;
+    RenderStateStats state_stats_;
+    RenderStateStats last_frame_state_stats_;
+    bool scissor_enabled_ = false;
+    SDL_Rect scissor_rect_ = {0, 0, 0, 0};
+
+    void applyDrawColor(const Color& color);
+    void applyClipRect(const SDL_Rect* rect);
+    void applyRenderTarget(SDL_Texture* target);
+    void applyViewport(const SDL_Rect* rect);
+    void applyScissor();
+
+    // Scene canvas for logical and dynamic resolution
+    static constexpr float MIN_RENDER_SCALE = 0.25f;
+    static constexpr int SCALE_SETTLE_FRAMES = 15;
+    static constexpr int RAISE_COOLDOWN_FRAMES = 120;
+    static constexpr int MAX_RAISE_COOLDOWN_FRAMES = 3840;
+
+    int logical_width_ = 0;
+    int logical_height_ = 0;
+    bool logical_integer_scale_ = false;
+    Canvas scene_canvas_;
+    float render_scale_ = 1.0f;
+
+    bool dynamic_resolution_ = false;
+    float frame_budget_ms_ = 1000.0f / 60.0f;
+    float min_render_scale_ = 0.5f;
+    float frame_time_avg_ms_ = 0.0f;
+    Uint64 last_present_ns_ = 0;
+    int frames_since_scale_change_ = 0;
+    int raise_cooldown_frames_ = RAISE_COOLDOWN_FRAMES;
+    bool last_change_was_raise_ = false;
+
+    bool sceneActive() const { return (logical_width_ > 0 && logical_height_ > 0) || dynamic_resolution_ || render_scale_ < 1.0f; }
+    int sceneWidth() const;
+    int sceneHeight() const;
+    bool drawingToScene() const;
+    SDL_Texture* screenTarget() const;
+    static SDL_Rect scaleRect(const SDL_Rect& rect, float scale);
+    void ensureSceneCanvas();
+    bool sceneDestRect(SDL_FRect* dst) const;
+    void presentScene();
+    void updateDynamicResolution();
+    void forgetTexture(SDL_Texture* texture);
+    void invalidateRenderState();
+
     // Text alignment helpers
     std::pair<HorizontalAlign, VerticalAlign> parseAlignment(const std::string& align);
     std::pair<float, float> calculateAlignedPosition(const std::string& text, float x, float y,
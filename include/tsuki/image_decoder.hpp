@@ -0,0 +1,58 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tsuki {
+
+// Decodes image files to RGBA32 on a small pool of worker threads. Results are
+// collected on the main thread, which owns all renderer work.
+class ImageDecoder {
+public:
+    struct Result {
+        uint64_t id = 0;
+        unsigned char* pixels = nullptr; // stb_image allocation, freed with freePixels
+        int width = 0;
+        int height = 0;
+    };
+
+    ImageDecoder() = default;
+    ~ImageDecoder();
+
+    ImageDecoder(const ImageDecoder&) = delete;
+    ImageDecoder& operator=(const ImageDecoder&) = delete;
+
+    // Starts the workers on first use; 0 picks a count from the hardware
+    void start(int threadCount = 0);
+    void stop();
+    bool isRunning() const { return !workers_.empty(); }
+
+    void enqueue(uint64_t id, const std::string& filename);
+
+    // Takes one finished result, if any; a null pixels pointer means decoding failed
+    bool poll(Result* result);
+
+    static void freePixels(unsigned char* pixels);
+
+private:
+    struct Job {
+        uint64_t id;
+        std::string filename;
+    };
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::deque<Job> jobs_;
+    std::deque<Result> results_;
+    bool stopping_ = false;
+
+    void workerLoop();
+};
+
+} // namespace tsuki
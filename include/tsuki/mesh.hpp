@@ -0,0 +1,53 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <vector>
+
+#include "graphics.hpp"
+
+namespace tsuki {
+
+// Retained triangle geometry with an optional image. Vertices are kept in SDL's
+// format between frames, so drawing costs one geometry submission and edits only
+// rewrite the vertices they touch.
+class Mesh {
+public:
+    // Layout of the flat arrays taken by setVertices: x, y, u, v, r, g, b, a
+    static constexpr size_t FLOATS_PER_VERTEX = 8;
+
+    // Without indices the vertices are drawn as a triangle list. Once the image is unloaded or
+    // replaced the handle goes stale and the mesh draws nothing.
+    explicit Mesh(size_t vertexCount, ImageHandle image = {});
+
+    // Overwrites count vertices starting at start; fails if the range runs past the end
+    bool setVertices(size_t start, const float* data, size_t count);
+    bool setVertex(size_t index, float x, float y, float u, float v, const Color& color = Color::white());
+
+    // Indices must be whole triangles within the vertex range; an empty set restores the default
+    bool setIndices(const int* indices, size_t count);
+
+    // Texture coordinates are normalized over the whole image. Atlased images are drawn from a
+    // standalone copy, so coordinates never reach neighbouring atlas space.
+    void setImage(ImageHandle image) { image_ = image; }
+    ImageHandle getImage() const { return image_; }
+
+    size_t getVertexCount() const { return vertices_.size(); }
+    const std::vector<SDL_Vertex>& getVertices() const { return vertices_; }
+    const std::vector<int>& getIndices() const { return indices_; }
+
+    // Bounds of all vertices, recomputed lazily after edits
+    void getBounds(float* x0, float* y0, float* x1, float* y1) const;
+
+private:
+    ImageHandle image_;
+
+    std::vector<SDL_Vertex> vertices_;
+    std::vector<int> indices_;
+
+    mutable SDL_FRect bounds_ = {0.0f, 0.0f, 0.0f, 0.0f}; // x, y = min, w, h = max
+    mutable bool bounds_dirty_ = true;
+
+    void resetIndices();
+};
+
+} // namespace tsuki
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+#include "graphics.hpp"
+
+namespace tsuki {
+
+// CPU particle emitter. Particle state is kept as separate float arrays
+// (structure of arrays) so the update loops stay branch-free and easy for the
+// compiler to vectorize; the whole system renders as one geometry submission.
+class ParticleSystem {
+public:
+    static constexpr int RAMP_SIZE = 64; // Resolution of the baked color and size ramps
+
+    // Without an image particles are untextured; once the image is unloaded or replaced
+    // the handle goes stale and the system draws nothing
+    explicit ParticleSystem(size_t maxParticles, ImageHandle image = {});
+
+    // Emitter configuration
+    void setPosition(float x, float y) { emitter_x_ = x; emitter_y_ = y; }
+    void setEmissionArea(float width, float height) { area_width_ = width; area_height_ = height; }
+    void setEmissionRate(float particlesPerSecond) { emission_rate_ = std::max(0.0f, particlesPerSecond); }
+    void setLifetime(float min, float max);
+    void setDirection(float angle) { direction_ = angle; }
+    void setSpread(float spread) { spread_ = spread; }
+    void setSpeed(float min, float max);
+    void setGravity(float gx, float gy) { gravity_x_ = gx; gravity_y_ = gy; }
+    void setDamping(float damping) { damping_ = std::max(0.0f, damping); }
+    void setSizes(const std::vector<float>& sizes);   // Evenly spaced over a particle's life
+    void setColors(const std::vector<Color>& colors); // Evenly spaced over a particle's life
+
+    void start() { active_ = true; }
+    void stop() { active_ = false; }
+    bool isActive() const { return active_; }
+    void reset();
+
+    void emit(size_t count);
+    void update(float dt);
+
+    size_t getCount() const { return count_; }
+    size_t getMaxParticles() const { return max_particles_; }
+    ImageHandle getImage() const { return image_; }
+
+    // Box around the live particles at their current sizes, for culling before any quads are built
+    void getBounds(float* x0, float* y0, float* x1, float* y1) const;
+
+    // Rebuilds the quads for the live particles, textured from `image` if given; valid until the next update
+    const std::vector<SDL_Vertex>& buildVertices(const Image* image);
+    const std::vector<int>& getIndices() const { return indices_; }
+
+private:
+    size_t max_particles_;
+    size_t count_ = 0;
+    ImageHandle image_;
+
+    // Particle state, one array per attribute
+    std::vector<float> x_, y_;
+    std::vector<float> vx_, vy_;
+    std::vector<float> age_;          // Normalized 0..1 over the particle's life
+    std::vector<float> age_rate_;     // 1 / lifetime
+
+    // Emitter state
+    float emitter_x_ = 0.0f, emitter_y_ = 0.0f;
+    float area_width_ = 0.0f, area_height_ = 0.0f;
+    float emission_rate_ = 0.0f;
+    float emission_accumulator_ = 0.0f;
+    float lifetime_min_ = 1.0f, lifetime_max_ = 1.0f;
+    float direction_ = 0.0f;
+    float spread_ = 0.0f;
+    float speed_min_ = 0.0f, speed_max_ = 0.0f;
+    float gravity_x_ = 0.0f, gravity_y_ = 0.0f;
+    float damping_ = 0.0f;
+    bool active_ = true;
+
+    std::array<SDL_FColor, RAMP_SIZE> color_ramp_;
+    std::array<float, RAMP_SIZE> size_ramp_;
+
+    std::vector<SDL_Vertex> vertices_;
+    std::vector<int> indices_;
+
+    std::mt19937 rng_;
+
+    float random(float min, float max);
+    void removeDead();
+};
+
+} // namespace tsuki
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <vector>
+
+namespace tsuki {
+
+// Simple polygon with optional holes, filled through a triangle list built by ear
+// clipping. The triangulation is cached and only redone after the points change.
+class Shape {
+public:
+    Shape() = default;
+
+    // Flat x, y coordinates; count is in points. Setting the outline keeps existing holes.
+    void setPoints(const float* coords, size_t count);
+    // Holes must lie inside the outline and not overlap each other; returns the hole index
+    int addHole(const float* coords, size_t count);
+    void clearHoles();
+
+    size_t getHoleCount() const { return contours_.empty() ? 0 : contours_.size() - 1; }
+
+    // Outline first, then each hole
+    const std::vector<SDL_FPoint>& getPoints() const { return points_; }
+    // Contour c covers points [starts[c], starts[c + 1]), the last one runs to the end
+    const std::vector<size_t>& getContourStarts() const { return contours_; }
+
+    // Indices into getPoints(), three per triangle; empty for fewer than three outline points
+    const std::vector<int>& getTriangles() const;
+
+    void getBounds(float* x0, float* y0, float* x1, float* y1) const;
+
+private:
+    std::vector<SDL_FPoint> points_;
+    std::vector<size_t> contours_; // Start of each contour in points_
+    size_t outline_count_ = 0;
+
+    mutable std::vector<int> triangles_;
+    mutable bool dirty_ = true;
+
+    void triangulate() const;
+    bool bridgeHole(std::vector<int>& ring, const std::vector<int>& hole) const;
+    void clipEars(const std::vector<int>& ring) const;
+};
+
+} // namespace tsuki
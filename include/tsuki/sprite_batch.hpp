@@ -0,0 +1,62 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <cmath>
+#include <vector>
+
+#include "graphics.hpp"
+
+namespace tsuki {
+
+// Retained set of textured quads sharing one image. Vertex data is rebuilt at draw
+// time only for sprites added or changed since the last draw and reused across
+// frames, so drawing the whole batch is a single geometry submission.
+class SpriteBatch {
+public:
+    struct Sprite {
+        float x = 0.0f, y = 0.0f;
+        float rotation = 0.0f;
+        float sx = 1.0f, sy = 1.0f;
+        float ox = 0.0f, oy = 0.0f;
+        SDL_FRect source = {0.0f, 0.0f, 0.0f, 0.0f}; // Pixel rect in the image, empty means whole image
+        Color color = Color::white();
+    };
+
+    // Once the image is unloaded or replaced the handle goes stale and the batch draws nothing
+    explicit SpriteBatch(ImageHandle image, size_t capacity = 1000);
+
+    int add(const Sprite& sprite);
+    bool set(int id, const Sprite& sprite);
+    void clear();
+
+    // Color used by the Lua helpers for sprites added without one
+    void setColor(const Color& color) { color_ = color; }
+    Color getColor() const { return color_; }
+
+    size_t getCount() const { return sprites_.size(); }
+    ImageHandle getImage() const { return image_; }
+
+    // Writes the vertices of sprites changed since the last call; image is what the handle resolves to
+    const std::vector<SDL_Vertex>& buildVertices(const Image& image);
+    const std::vector<int>& getIndices() const { return indices_; }
+    // Box around every sprite written so far; it only grows until clear(), and is empty (x0 > x1)
+    // while nothing visible has been written
+    void getBounds(float* x0, float* y0, float* x1, float* y1) const;
+
+private:
+    ImageHandle image_;
+    Color color_ = Color::white();
+
+    std::vector<Sprite> sprites_;
+    std::vector<SDL_Vertex> vertices_;
+    std::vector<int> indices_;
+    size_t dirty_begin_ = 0; // Sprites in [dirty_begin_, dirty_end_) need their vertices written
+    size_t dirty_end_ = 0;
+    float bounds_x0_ = INFINITY, bounds_y0_ = INFINITY;
+    float bounds_x1_ = -INFINITY, bounds_y1_ = -INFINITY;
+
+    void markDirty(size_t index);
+    void writeSprite(const Image& image, size_t index);
+};
+
+} // namespace tsuki
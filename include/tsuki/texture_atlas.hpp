@@ -0,0 +1,66 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <vector>
+
+namespace tsuki {
+
+// Packs small RGBA images into shared texture pages using a skyline packer,
+// so sprites from different files can be drawn in the same batch.
+class TextureAtlas {
+public:
+    static constexpr int PAGE_SIZE = 1024;
+    static constexpr int MAX_IMAGE_SIZE = 256;
+    static constexpr int PADDING = 1; // Extruded border around every image
+
+    struct Region {
+        SDL_Texture* texture = nullptr;
+        int page = -1;
+        SDL_Rect rect = {0, 0, 0, 0}; // Pixel rect of the image inside the page, padding excluded
+        int pageWidth = 0;
+        int pageHeight = 0;
+    };
+
+    struct PageStats {
+        int width = 0;
+        int height = 0;
+        int usedPixels = 0;
+        int imageCount = 0;
+        float usage = 0.0f; // usedPixels relative to the page area
+    };
+
+    TextureAtlas() = default;
+    ~TextureAtlas();
+
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    // Copies RGBA32 pixels into a page; returns false if the image is too large for the atlas
+    bool insert(SDL_Renderer* renderer, const unsigned char* pixels, int width, int height, int pitch,
+                Region* region);
+    void release(int page, int width, int height);
+    void clear();
+
+    std::vector<PageStats> getStats() const;
+
+private:
+    struct SkylineNode {
+        int x, y, width;
+    };
+
+    struct Page {
+        SDL_Texture* texture = nullptr;
+        std::vector<SkylineNode> skyline;
+        int usedPixels = 0;
+        int imageCount = 0;
+    };
+
+    std::vector<Page> pages_;
+
+    bool createPage(SDL_Renderer* renderer);
+    static void resetSkyline(Page& page);
+    static int fitSkyline(const Page& page, size_t index, int width, int height);
+    static bool packSkyline(Page& page, int width, int height, int* x, int* y);
+};
+
+} // namespace tsuki
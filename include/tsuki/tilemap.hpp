@@ -0,0 +1,94 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "graphics.hpp"
+
+namespace tsuki {
+
+// Grid of tiles from a single tileset image, split into square chunks. Each
+// chunk keeps prebuilt geometry per layer that is only rebuilt after one of
+// its tiles changes, and only chunks overlapping the view get submitted.
+class Tilemap {
+public:
+    static constexpr int DEFAULT_CHUNK_SIZE = 32; // Tiles per chunk side
+    static constexpr int EMPTY_TILE = 0;          // Tile ids are 1-based cells of the tileset, row-major
+
+    // Once the tileset is unloaded or replaced the handle goes stale and the map draws nothing
+    Tilemap(ImageHandle tileset, int tileWidth, int tileHeight, int width, int height,
+            int layers = 1, int chunkSize = DEFAULT_CHUNK_SIZE);
+
+    void setTile(int layer, int x, int y, int tile);
+    int getTile(int layer, int x, int y) const;
+    void fill(int layer, int tile);
+
+    int getWidth() const { return width_; }
+    int getHeight() const { return height_; }
+    int getLayerCount() const { return layers_; }
+    int getTileWidth() const { return tile_width_; }
+    int getTileHeight() const { return tile_height_; }
+    ImageHandle getTileset() const { return tileset_; }
+
+    // Calls fn(vertices, indices) for every non-empty chunk of `layer` that overlaps the
+    // given rect in map pixels, rebuilding stale chunk geometry from `tileset` on the way
+    template <typename Fn>
+    void forEachVisibleChunk(const Image& tileset, int layer, float x0, float y0, float x1, float y1, Fn&& fn);
+
+private:
+    struct Chunk {
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+        bool dirty = true;
+    };
+
+    ImageHandle tileset_;
+    int tile_width_;
+    int tile_height_;
+    int width_;
+    int height_;
+    int layers_;
+    int chunk_size_;
+    int chunks_x_;
+    int chunks_y_;
+
+    std::vector<int> tiles_;     // layer-major, then row-major
+    std::vector<Chunk> chunks_;  // layer-major, then row-major
+
+    bool inBounds(int layer, int x, int y) const {
+        return layer >= 0 && layer < layers_ && x >= 0 && x < width_ && y >= 0 && y < height_;
+    }
+    Chunk& chunkAt(int layer, int cx, int cy) { return chunks_[(layer * chunks_y_ + cy) * chunks_x_ + cx]; }
+    void rebuildChunk(const Image& tileset, int layer, int cx, int cy);
+};
+
+template <typename Fn>
+void Tilemap::forEachVisibleChunk(const Image& tileset, int layer, float x0, float y0, float x1, float y1, Fn&& fn) {
+    if (layer < 0 || layer >= layers_ || x1 <= x0 || y1 <= y0) {
+        return;
+    }
+
+    const float chunkWidth = static_cast<float>(chunk_size_ * tile_width_);
+    const float chunkHeight = static_cast<float>(chunk_size_ * tile_height_);
+
+    const int firstX = std::max(0, static_cast<int>(std::floor(x0 / chunkWidth)));
+    const int firstY = std::max(0, static_cast<int>(std::floor(y0 / chunkHeight)));
+    const int lastX = std::min(chunks_x_ - 1, static_cast<int>(std::floor(x1 / chunkWidth)));
+    const int lastY = std::min(chunks_y_ - 1, static_cast<int>(std::floor(y1 / chunkHeight)));
+
+    for (int cy = firstY; cy <= lastY; ++cy) {
+        for (int cx = firstX; cx <= lastX; ++cx) {
+            Chunk& chunk = chunkAt(layer, cx, cy);
+            if (chunk.dirty) {
+                rebuildChunk(tileset, layer, cx, cy);
+            }
+            if (!chunk.indices.empty()) {
+                fn(chunk.vertices, chunk.indices);
+            }
+        }
+    }
+}
+
+} // namespace tsuki
@@ -1,16 +1,22 @@
 #pragma once
 
 #include "audio.hpp"
+#include "camera.hpp"
 #include "event.hpp"
 #include "graphics.hpp"
 #include "keyboard.hpp"
 #include "lua_engine.hpp"
 #include "lua_bindings.hpp"
 #include "math.hpp"
+#include "mesh.hpp"
 #include "mouse.hpp"
 #include "packaging.hpp"
+#include "particle_system.hpp"
 #include "platform.hpp"
+#include "shape.hpp"
+#include "sprite_batch.hpp"
 #include "system.hpp"
+#include "tilemap.hpp"
 #include "timer.hpp"
 #include "window.hpp"
 
@@ -25,6 +31,14 @@ public:
     void runLuaGame(const std::string& game_path);
     void quit();
 
+    // Headless runs use SDL's offscreen (or dummy) video driver and a software renderer.
+    // Both settings must be made before init().
+    void setHeadless(bool headless) { headless_ = headless; }
+    bool isHeadless() const { return headless_; }
+    // Stop after this many frames; 0 runs until the game quits
+    void setMaxFrames(uint64_t frames) { max_frames_ = frames; }
+    uint64_t getMaxFrames() const { return max_frames_; }
+
     void setLoadCallback(std::function<void()> callback);
     void setUpdateCallback(std::function<void(double)> callback);
     void setDrawCallback(std::function<void()> callback);
@@ -47,6 +61,20 @@ private:
     Engine& operator=(const Engine&) = delete;
 
     bool running_ = false;
+    bool headless_ = false;
+    uint64_t max_frames_ = 0;
+
+    // Frame timing, reported at exit for headless runs
+    struct FrameStats {
+        uint64_t frames = 0;
+        uint64_t update_ticks = 0;
+        uint64_t present_ticks = 0;
+        uint64_t start_ticks = 0;
+    };
+    FrameStats frame_stats_;
+
+    bool frameLimitReached() const { return max_frames_ > 0 && frame_stats_.frames >= max_frames_; }
+    void reportFrameStats() const;
 
     std::function<void()> load_callback_;
     std::function<void(double)> update_callback_;
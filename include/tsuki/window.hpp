@@ -14,6 +14,7 @@ struct WindowSettings {
     bool resizable = true;
     bool vsync = true;
     int display = 0;
+    bool headless = false; // Hidden window and software renderer, for machines without a display
 };
 
 class Window {
@@ -60,16 +61,20 @@ public:
 
     SDL_Window* getSDLWindow() const { return window_; }
     SDL_Renderer* getRenderer() const { return renderer_; }
+    bool isHeadless() const { return headless_; }
 
 private:
     SDL_Window* window_ = nullptr;
     SDL_Renderer* renderer_ = nullptr;
+    SDL_Surface* surface_ = nullptr; // Render target when headless without a window
+    bool headless_ = false;
     bool should_close_ = false;
 
     std::function<void(int, int)> resize_callback_;
     std::function<void()> close_callback_;
 
     void handleEvent(const SDL_Event& event);
+    bool initHeadless(const WindowSettings& settings);
 };
 
 } // namespace tsuki
\ No newline at end of file
@@ -0,0 +1,41 @@
+#include "tsuki/camera.hpp"
+#include <algorithm>
+
+namespace tsuki {
+
+void Camera::setPosition(float x, float y) {
+    x_ = x;
+    y_ = y;
+    ++revision_;
+}
+
+void Camera::move(float dx, float dy) {
+    x_ += dx;
+    y_ += dy;
+    ++revision_;
+}
+
+void Camera::setZoom(float zoom) {
+    // A zero zoom would make the view transform singular
+    zoom_ = std::max(zoom, 0.0001f);
+    ++revision_;
+}
+
+void Camera::setRotation(float rotation) {
+    rotation_ = rotation;
+    ++revision_;
+}
+
+void Camera::setViewport(int x, int y, int width, int height) {
+    viewport_ = {x, y, std::max(0, width), std::max(0, height)};
+    has_viewport_ = viewport_.w > 0 && viewport_.h > 0;
+    ++revision_;
+}
+
+void Camera::clearViewport() {
+    viewport_ = {0, 0, 0, 0};
+    has_viewport_ = false;
+    ++revision_;
+}
+
+} // namespace tsuki
@@ -24,7 +24,9 @@ void HelpCommand::printUsage() {
     std::cout << "  Running games:\n";
     std::cout << "    " << program_name_ << " <game_directory>     Run a game from directory\n";
     std::cout << "    " << program_name_ << " <game.tsuki>        Run a .tsuki game file\n";
-    std::cout << "    " << program_name_ << "                     Run if executable contains embedded game\n\n";
+    std::cout << "    " << program_name_ << "                     Run if executable contains embedded game\n";
+    std::cout << "    " << program_name_ << " <game> --headless    Run without a display (software renderer)\n";
+    std::cout << "    " << program_name_ << " <game> --frames <n>  Quit after n frames\n\n";
 
     std::cout << "  Packaging:\n";
     std::cout << "    " << program_name_ << " --package <dir> <output.tsuki>          Create .tsuki file from directory\n";
@@ -2,18 +2,22 @@
 #include "../utils/cli_utils.hpp"
 #include <tsuki/tsuki.hpp>
 #include <tsuki/packaging.hpp>
+#include <cstdlib>
 #include <filesystem>
 #include <iostream>
 
 namespace tsuki::cli {
 
 int RunCommand::execute(int argc, char* argv[]) {
-    // No arguments - check if this is a fused executable
-    if (argc == 1) {
-        return runFusedExecutable(argv[0]);
+    std::string game_path;
+    if (!parseRunOptions(argc, argv, &game_path)) {
+        return 1;
     }
 
-    std::string game_path = argv[1];
+    // No game path - check if this is a fused executable
+    if (game_path.empty()) {
+        return runFusedExecutable(argv[0]);
+    }
 
     // Auto-detect .tsuki files
     if (!endsWith(game_path, ".tsuki") &&
@@ -59,8 +63,42 @@ int RunCommand::execute(int argc, char* argv[]) {
     return runGame(game_path);
 }
 
+// Options on either side of the game path (a fused executable has none), or the
+// TSUKI_HEADLESS / TSUKI_FRAMES environment variables. The first other argument is the game path.
+bool RunCommand::parseRunOptions(int argc, char* argv[], std::string* game_path) {
+    const char* headless_env = std::getenv("TSUKI_HEADLESS");
+    if (headless_env && *headless_env && std::string(headless_env) != "0") {
+        headless_ = true;
+    }
+
+    const char* frames_env = std::getenv("TSUKI_FRAMES");
+    if (frames_env) {
+        max_frames_ = std::strtoull(frames_env, nullptr, 10);
+    }
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--headless") {
+            headless_ = true;
+        } else if (arg == "--frames") {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: --frames requires a value" << std::endl;
+                return false;
+            }
+            max_frames_ = std::strtoull(argv[++i], nullptr, 10);
+        } else if (game_path->empty() && arg.rfind("--", 0) != 0) {
+            *game_path = arg;
+        } else {
+            std::cerr << "Warning: Unknown option '" << arg << "' ignored" << std::endl;
+        }
+    }
+    return true;
+}
+
 int RunCommand::runGame(const std::string& game_path) {
     auto& engine = tsuki::Engine::getInstance();
+    engine.setHeadless(headless_);
+    engine.setMaxFrames(max_frames_);
     if (!engine.init()) {
         std::cerr << "Failed to initialize Tsuki!" << std::endl;
         return 1;
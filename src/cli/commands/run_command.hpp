@@ -1,6 +1,7 @@
 #pragma once
 
 #include "command_base.hpp"
+#include <cstdint>
 
 namespace tsuki::cli {
 
@@ -13,6 +14,10 @@ public:
 private:
     int runGame(const std::string& game_path);
     int runFusedExecutable(const char* argv0);
+    bool parseRunOptions(int argc, char* argv[], std::string* game_path);
+
+    bool headless_ = false;
+    uint64_t max_frames_ = 0;
 };
 
 } // namespace tsuki::cli
\ No newline at end of file
@@ -234,35 +234,345 @@ void DefinitionsGenerator::getMethodSignature(const std::string& class_name, con
             params = "mode: string, x: number, y: number, width: number, height: number";
             return_type = "nil";
         } else if (method_name == "circle") {
-            params = "mode: string, x: number, y: number, radius: number";
+            params = "mode: string, x: number, y: number, radius: number, segments: integer?";
             return_type = "nil";
+        } else if (method_name == "polygon") {
+            params = "mode: string, points: number[]|Shape";
+            return_type = "nil";
+        } else if (method_name == "newShape") {
+            params = "points: number[]|ffi.cdata*, count: integer?";
+            return_type = "Shape";
         } else if (method_name == "line") {
             params = "x1: number, y1: number, x2: number, y2: number";
             return_type = "nil";
         } else if (method_name == "point") {
             params = "x: number, y: number";
             return_type = "nil";
+        } else if (method_name == "push" || method_name == "pop" || method_name == "origin") {
+            params = "";
+            return_type = "nil";
+        } else if (method_name == "translate") {
+            params = "x: number, y: number";
+            return_type = "nil";
+        } else if (method_name == "rotate") {
+            params = "angle: number";
+            return_type = "nil";
+        } else if (method_name == "scale") {
+            params = "sx: number, sy: number";
+            return_type = "nil";
+        } else if (method_name == "transformPoint" || method_name == "inverseTransformPoint") {
+            params = "x: number, y: number";
+            return_type = "number, number";
         } else if (method_name == "print") {
             params = "text: string, x: number, y: number, align: string?";
             return_type = "nil";
+        } else if (method_name == "printf") {
+            params = "text: string, x: number, y: number, limit: number, align: string?";
+            return_type = "nil";
         } else if (method_name == "getTextSize") {
             params = "text: string";
             return_type = "number, number";
+        } else if (method_name == "setFontFallbacks") {
+            params = "name: string, fallbacks: string[]";
+            return_type = "boolean";
         } else if (method_name == "loadFont") {
-            params = "path: string, size: number";
-            return_type = "string";
+            params = "name: string, path: string, size: number?, sdf: boolean?";
+            return_type = "boolean";
         } else if (method_name == "setFont") {
             params = "fontId: string";
             return_type = "nil";
         } else if (method_name == "loadImage") {
-            params = "path: string";
-            return_type = "string";
+            params = "imageId: string, path: string";
+            return_type = "Image?";
         } else if (method_name == "unloadImage") {
+            params = "image: Image|string";
+            return_type = "boolean";
+        } else if (method_name == "getImage") {
             params = "imageId: string";
-            return_type = "nil";
+            return_type = "Image?";
         } else if (method_name == "draw") {
-            params = "imageId: string, x: number, y: number";
+            params = "drawable: Image|string|Canvas|SpriteBatch|Mesh|Tilemap|ParticleSystem, x: number?, y: number?, layer: integer?";
+            return_type = "nil";
+        } else if (method_name == "newCanvas" || method_name == "acquireCanvas") {
+            params = "width: integer, height: integer";
+            return_type = "Canvas?";
+        } else if (method_name == "setCanvas") {
+            params = "canvas: Canvas?";
+            return_type = "nil";
+        } else if (method_name == "getCanvas") {
+            params = "";
+            return_type = "Canvas?";
+        } else if (method_name == "releaseCanvas") {
+            params = "canvas: Canvas";
+            return_type = "nil";
+        } else if (method_name == "newTilemap") {
+            params = "image: Image|string, tileWidth: integer, tileHeight: integer, width: integer, height: integer, layers: integer?";
+            return_type = "Tilemap?";
+        } else if (method_name == "newParticleSystem") {
+            params = "maxParticles: integer, image: Image|string|nil";
+            return_type = "ParticleSystem";
+        } else if (method_name == "points" || method_name == "lines" || method_name == "triangles") {
+            params = "coords: number[]|ffi.cdata*, count: integer?";
+            return_type = "nil";
+        } else if (method_name == "polyline") {
+            params = "coords: number[]|ffi.cdata*, count: integer?";
+            return_type = "nil";
+        } else if (method_name == "setLineWidth") {
+            params = "width: number";
+            return_type = "nil";
+        } else if (method_name == "getLineWidth") {
+            params = "";
+            return_type = "number";
+        } else if (method_name == "setLineJoin") {
+            params = "join: string";
+            return_type = "nil";
+        } else if (method_name == "getLineJoin") {
+            params = "";
+            return_type = "string";
+        } else if (method_name == "rectangles") {
+            params = "mode: string, rects: number[]|ffi.cdata*, count: integer?";
+            return_type = "nil";
+        } else if (method_name == "setScissor") {
+            params = "x: integer?, y: integer?, width: integer?, height: integer?";
+            return_type = "nil";
+        } else if (method_name == "getRenderStateStats") {
+            params = "";
+            return_type = "{issued: integer, skipped: integer}";
+        } else if (method_name == "newCamera") {
+            params = "";
+            return_type = "Camera";
+        } else if (method_name == "setCamera") {
+            params = "camera: Camera?";
+            return_type = "nil";
+        } else if (method_name == "getCamera") {
+            params = "";
+            return_type = "Camera?";
+        } else if (method_name == "getCullStats") {
+            params = "";
+            return_type = "{culled: integer}";
+        } else if (method_name == "setLogicalSize") {
+            params = "width: integer, height: integer, integerScale: boolean?";
+            return_type = "nil";
+        } else if (method_name == "getLogicalSize") {
+            params = "";
+            return_type = "integer, integer";
+        } else if (method_name == "toLogical") {
+            params = "x: number, y: number";
+            return_type = "number, number";
+        } else if (method_name == "setRenderScale") {
+            params = "scale: number";
             return_type = "nil";
+        } else if (method_name == "getRenderScale") {
+            params = "";
+            return_type = "number";
+        } else if (method_name == "setDynamicResolution") {
+            params = "enabled: boolean, frameBudgetMs: number?, minScale: number?";
+            return_type = "nil";
+        } else if (method_name == "isDynamicResolution") {
+            params = "";
+            return_type = "boolean";
+        } else if (method_name == "setDeferred") {
+            params = "deferred: boolean";
+            return_type = "nil";
+        } else if (method_name == "isDeferred") {
+            params = "";
+            return_type = "boolean";
+        } else if (method_name == "setLayer") {
+            params = "layer: integer";
+            return_type = "nil";
+        } else if (method_name == "getLayer") {
+            params = "";
+            return_type = "integer";
+        } else if (method_name == "setDepth") {
+            params = "depth: number";
+            return_type = "nil";
+        } else if (method_name == "getDepth") {
+            params = "";
+            return_type = "number";
+        } else if (method_name == "getDrawQueueStats") {
+            params = "";
+            return_type = "{items: integer, batches: integer, batchesSaved: integer}";
+        } else if (method_name == "getAtlasStats") {
+            params = "";
+            return_type = "{width: integer, height: integer, images: integer, usage: number}[]";
+        } else if (method_name == "loadImageAsync") {
+            params = "imageId: string, path: string";
+            return_type = "ImageLoad";
+        } else if (method_name == "setImageUploadBudget") {
+            params = "milliseconds: number";
+            return_type = "nil";
+        } else if (method_name == "getImageUploadBudget") {
+            params = "";
+            return_type = "number";
+        } else if (method_name == "getImageLoadProgress") {
+            params = "";
+            return_type = "{total: integer, completed: integer, failed: integer, fraction: number}";
+        } else if (method_name == "setTextureBudget") {
+            params = "bytes: integer";
+            return_type = "nil";
+        } else if (method_name == "getTextureBudget") {
+            params = "";
+            return_type = "integer";
+        } else if (method_name == "getTextureStats") {
+            params = "";
+            return_type = "{residentBytes: integer, budgetBytes: integer, residentImages: integer, evictedImages: integer, evictions: integer, reloads: integer}";
+        } else if (method_name == "newSpriteBatch") {
+            params = "image: Image|string, capacity: integer?";
+            return_type = "SpriteBatch?";
+        } else if (method_name == "newMesh") {
+            params = "vertexCount: integer, image: Image|string|nil";
+            return_type = "Mesh";
+        }
+    } else if (class_name == "ImageLoad") {
+        if (method_name == "isDone" || method_name == "isReady" || method_name == "isFailed") {
+            params = "";
+            return_type = "boolean";
+        } else if (method_name == "getImage") {
+            params = "";
+            return_type = "Image?";
+        } else if (method_name == "getName") {
+            params = "";
+            return_type = "string";
+        }
+    } else if (class_name == "Camera") {
+        if (method_name == "setPosition" || method_name == "move") {
+            params = "x: number, y: number";
+            return_type = "nil";
+        } else if (method_name == "getPosition") {
+            params = "";
+            return_type = "number, number";
+        } else if (method_name == "setZoom") {
+            params = "zoom: number";
+            return_type = "nil";
+        } else if (method_name == "setRotation") {
+            params = "angle: number";
+            return_type = "nil";
+        } else if (method_name == "getZoom" || method_name == "getRotation") {
+            params = "";
+            return_type = "number";
+        } else if (method_name == "setViewport") {
+            params = "x: integer?, y: integer?, width: integer?, height: integer?";
+            return_type = "nil";
+        } else if (method_name == "getViewport") {
+            params = "";
+            return_type = "integer?, integer?, integer?, integer?";
+        }
+    } else if (class_name == "Canvas") {
+        if (method_name == "getWidth" || method_name == "getHeight") {
+            params = "";
+            return_type = "integer";
+        }
+    } else if (class_name == "Tilemap") {
+        if (method_name == "setTile") {
+            params = "layer: integer, x: integer, y: integer, tile: integer";
+            return_type = "nil";
+        } else if (method_name == "getTile") {
+            params = "layer: integer, x: integer, y: integer";
+            return_type = "integer";
+        } else if (method_name == "setTiles") {
+            params = "layer: integer, tiles: integer[]";
+            return_type = "nil";
+        } else if (method_name == "fill") {
+            params = "layer: integer, tile: integer";
+            return_type = "nil";
+        } else if (method_name == "getWidth" || method_name == "getHeight" || method_name == "getLayerCount") {
+            params = "";
+            return_type = "integer";
+        }
+    } else if (class_name == "ParticleSystem") {
+        if (method_name == "setPosition" || method_name == "setGravity") {
+            params = "x: number, y: number";
+            return_type = "nil";
+        } else if (method_name == "setEmissionArea") {
+            params = "width: number, height: number";
+            return_type = "nil";
+        } else if (method_name == "setEmissionRate") {
+            params = "particlesPerSecond: number";
+            return_type = "nil";
+        } else if (method_name == "setLifetime" || method_name == "setSpeed") {
+            params = "min: number, max: number";
+            return_type = "nil";
+        } else if (method_name == "setDirection" || method_name == "setSpread") {
+            params = "angle: number";
+            return_type = "nil";
+        } else if (method_name == "setDamping") {
+            params = "damping: number";
+            return_type = "nil";
+        } else if (method_name == "setSizes") {
+            params = "...: number";
+            return_type = "nil";
+        } else if (method_name == "setColors") {
+            params = "...: number";
+            return_type = "nil";
+        } else if (method_name == "emit") {
+            params = "count: integer";
+            return_type = "nil";
+        } else if (method_name == "update") {
+            params = "dt: number";
+            return_type = "nil";
+        } else if (method_name == "start" || method_name == "stop" || method_name == "reset") {
+            params = "";
+            return_type = "nil";
+        } else if (method_name == "isActive") {
+            params = "";
+            return_type = "boolean";
+        } else if (method_name == "getCount") {
+            params = "";
+            return_type = "integer";
+        }
+    } else if (class_name == "SpriteBatch") {
+        if (method_name == "add") {
+            params = "x: number, y: number, r: number?, sx: number?, sy: number?, ox: number?, oy: number?";
+            return_type = "integer";
+        } else if (method_name == "addRect") {
+            params = "qx: number, qy: number, qw: number, qh: number, x: number, y: number, r: number?, sx: number?, sy: number?, ox: number?, oy: number?";
+            return_type = "integer";
+        } else if (method_name == "set") {
+            params = "id: integer, x: number, y: number, r: number?, sx: number?, sy: number?, ox: number?, oy: number?";
+            return_type = "boolean";
+        } else if (method_name == "setRect") {
+            params = "id: integer, qx: number, qy: number, qw: number, qh: number, x: number, y: number, r: number?, sx: number?, sy: number?, ox: number?, oy: number?";
+            return_type = "boolean";
+        } else if (method_name == "setColor") {
+            params = "r: number, g: number, b: number, a: number";
+            return_type = "nil";
+        } else if (method_name == "clear") {
+            params = "";
+            return_type = "nil";
+        } else if (method_name == "getCount") {
+            params = "";
+            return_type = "integer";
+        }
+    } else if (class_name == "Shape") {
+        if (method_name == "setPoints") {
+            params = "points: number[]|ffi.cdata*, count: integer?";
+            return_type = "nil";
+        } else if (method_name == "addHole") {
+            params = "points: number[]|ffi.cdata*, count: integer?";
+            return_type = "integer?";
+        } else if (method_name == "clearHoles") {
+            params = "";
+            return_type = "nil";
+        } else if (method_name == "getHoleCount" || method_name == "getTriangleCount") {
+            params = "";
+            return_type = "integer";
+        }
+    } else if (class_name == "Mesh") {
+        if (method_name == "setVertices") {
+            params = "start: integer, vertices: number[]|ffi.cdata*, count: integer?";
+            return_type = "boolean";
+        } else if (method_name == "setVertex") {
+            params = "index: integer, x: number, y: number, u: number, v: number, r: number?, g: number?, b: number?, a: number?";
+            return_type = "boolean";
+        } else if (method_name == "setIndices") {
+            params = "indices: integer[]?";
+            return_type = "boolean";
+        } else if (method_name == "setImage") {
+            params = "image: Image|string|nil";
+            return_type = "nil";
+        } else if (method_name == "getVertexCount") {
+            params = "";
+            return_type = "integer";
         }
     } else if (class_name == "Keyboard") {
         if (method_name == "isDown") {
@@ -25,8 +25,18 @@ Engine& Engine::getInstance() {
 }
 
 bool Engine::init() {
+    // Headless runs prefer the offscreen driver and fall back to dummy where it isn't built in
+    if (headless_) {
+        SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+    }
+
     // Initialize SDL (video and events only - audio is handled by miniaudio)
-    if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS)) {
+    bool sdl_ready = SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS);
+    if (!sdl_ready && headless_) {
+        SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+        sdl_ready = SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS);
+    }
+    if (!sdl_ready) {
         std::cerr << "Failed to initialize SDL: " << SDL_GetError() << std::endl;
         return false;
     }
@@ -51,7 +61,9 @@ bool Engine::init() {
 #endif
 
     // Initialize window
-    if (!window_.init()) {
+    WindowSettings window_settings;
+    window_settings.headless = headless_;
+    if (!window_.init(window_settings)) {
 #ifdef TSUKI_HAS_SDL_TTF
         TTF_Quit();
 #endif
@@ -63,8 +75,9 @@ bool Engine::init() {
     }
 
     // Try adaptive VSync first (allows higher FPS while preventing tearing)
-    // Fall back to regular VSync if adaptive isn't supported
-    if (!window_.setVSync(-1)) { // SDL_RENDERER_VSYNC_ADAPTIVE
+    // Fall back to regular VSync if adaptive isn't supported.
+    // Headless runs are meant to go as fast as possible, so they skip it.
+    if (!headless_ && !window_.setVSync(-1)) { // SDL_RENDERER_VSYNC_ADAPTIVE
         window_.setVSync(true);
     }
 
@@ -126,8 +139,10 @@ void Engine::run() {
     }
 
     timer_.update();
+    frame_stats_ = {};
+    frame_stats_.start_ticks = SDL_GetPerformanceCounter();
 
-    while (running_ && !window_.shouldClose()) {
+    while (running_ && !window_.shouldClose() && !frameLimitReached()) {
         timer_.update();
         double dt = timer_.getDelta();
 
@@ -135,6 +150,7 @@ void Engine::run() {
         keyboard_.update();
         mouse_.update();
 
+        const Uint64 update_start = SDL_GetPerformanceCounter();
         if (update_callback_) {
             update_callback_(dt);
         }
@@ -145,9 +161,17 @@ void Engine::run() {
             draw_callback_();
         }
 
+        const Uint64 present_start = SDL_GetPerformanceCounter();
         graphics_.present();
+
+        frame_stats_.update_ticks += present_start - update_start;
+        frame_stats_.present_ticks += SDL_GetPerformanceCounter() - present_start;
+        ++frame_stats_.frames;
     }
 
+    if (headless_) {
+        reportFrameStats();
+    }
     quit();
 }
 
@@ -185,9 +209,11 @@ void Engine::runLuaGame(const std::string& game_path) {
     lua_engine_.callStart();
 
     timer_.update();
+    frame_stats_ = {};
+    frame_stats_.start_ticks = SDL_GetPerformanceCounter();
 
     // Main game loop
-    while (running_ && !window_.shouldClose()) {
+    while (running_ && !window_.shouldClose() && !frameLimitReached()) {
         try {
             timer_.update();
             double dt = timer_.getDelta();
@@ -199,9 +225,15 @@ void Engine::runLuaGame(const std::string& game_path) {
             graphics_.clear();
 
             // Call update(dt) for game logic and rendering
+            const Uint64 update_start = SDL_GetPerformanceCounter();
             lua_engine_.callUpdate(dt);
 
+            const Uint64 present_start = SDL_GetPerformanceCounter();
             graphics_.present();
+
+            frame_stats_.update_ticks += present_start - update_start;
+            frame_stats_.present_ticks += SDL_GetPerformanceCounter() - present_start;
+            ++frame_stats_.frames;
         } catch (const std::exception& e) {
             std::cerr << "Critical engine error: " << e.what() << std::endl;
             std::cerr << "Attempting to continue..." << std::endl;
@@ -225,6 +257,10 @@ void Engine::runLuaGame(const std::string& game_path) {
         }
     }
 
+    if (headless_) {
+        reportFrameStats();
+    }
+
     // Restore original working directory
     try {
         std::filesystem::current_path(original_cwd);
@@ -235,6 +271,21 @@ void Engine::runLuaGame(const std::string& game_path) {
     quit();
 }
 
+void Engine::reportFrameStats() const {
+    const double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+    const double total = (SDL_GetPerformanceCounter() - frame_stats_.start_ticks) / frequency;
+    const uint64_t frames = frame_stats_.frames;
+
+    std::cout << "Frames: " << frames << " in " << total << " s";
+    if (frames > 0 && total > 0.0) {
+        const double per_frame = 1000.0 / static_cast<double>(frames);
+        std::cout << " (" << frames / total << " fps)\n"
+                  << "  update: " << frame_stats_.update_ticks / frequency * per_frame << " ms/frame\n"
+                  << "  present: " << frame_stats_.present_ticks / frequency * per_frame << " ms/frame";
+    }
+    std::cout << std::endl;
+}
+
 void Engine::quit() {
     running_ = false;
 
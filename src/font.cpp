@@ -4,12 +4,13 @@
 #include "tsuki/font.hpp"
 #include <fstream>
 #include <iostream>
+#include <algorithm>
 #include <cstring>
 #include <cstdio>
 
 namespace tsuki {
 
-Font::Font() : stbFont_(nullptr), size_(20.0f), scale_(1.0f) {
+Font::Font() : stbFont_(nullptr), size_(20.0f), scale_(1.0f), ascent_(0.0f), lineHeight_(0.0f) {
 }
 
 Font::~Font() {
@@ -18,40 +19,119 @@ Font::~Font() {
 
 Font::Font(Font&& other) noexcept
     : fontData_(std::move(other.fontData_)),
+      source_(std::move(other.source_)),
       stbFont_(other.stbFont_),
       size_(other.size_),
-      scale_(other.scale_) {
+      scale_(other.scale_),
+      ascent_(other.ascent_),
+      lineHeight_(other.lineHeight_),
+      descent_(other.descent_),
+      advanceTable_(std::move(other.advanceTable_)),
+      kerningTable_(std::move(other.kerningTable_)),
+      glyphs_(std::move(other.glyphs_)),
+      atlasPages_(std::move(other.atlasPages_)),
+      sdf_(std::move(other.sdf_)),
+      sdfScale_(other.sdfScale_),
+      glyphIndexDense_(std::move(other.glyphIndexDense_)),
+      glyphIndexSparse_(std::move(other.glyphIndexSparse_)),
+      fallbacks_(std::move(other.fallbacks_)),
+      fallbackGlyphs_(std::move(other.fallbackGlyphs_)) {
     other.stbFont_ = nullptr;
     other.size_ = 0.0f;
     other.scale_ = 0.0f;
+    other.ascent_ = 0.0f;
+    other.lineHeight_ = 0.0f;
+    other.glyphs_.clear();
+    other.atlasPages_.clear();
 }
 
 Font& Font::operator=(Font&& other) noexcept {
     if (this != &other) {
         cleanup();
         fontData_ = std::move(other.fontData_);
+        source_ = std::move(other.source_);
         stbFont_ = other.stbFont_;
         size_ = other.size_;
         scale_ = other.scale_;
+        ascent_ = other.ascent_;
+        lineHeight_ = other.lineHeight_;
+        descent_ = other.descent_;
+        advanceTable_ = std::move(other.advanceTable_);
+        kerningTable_ = std::move(other.kerningTable_);
+        glyphs_ = std::move(other.glyphs_);
+        atlasPages_ = std::move(other.atlasPages_);
+        sdf_ = std::move(other.sdf_);
+        sdfScale_ = other.sdfScale_;
+        glyphIndexDense_ = std::move(other.glyphIndexDense_);
+        glyphIndexSparse_ = std::move(other.glyphIndexSparse_);
+        fallbacks_ = std::move(other.fallbacks_);
+        fallbackGlyphs_ = std::move(other.fallbackGlyphs_);
 
         other.stbFont_ = nullptr;
         other.size_ = 0.0f;
         other.scale_ = 0.0f;
+        other.ascent_ = 0.0f;
+        other.lineHeight_ = 0.0f;
+        other.glyphs_.clear();
+        other.atlasPages_.clear();
     }
     return *this;
 }
 
 void Font::cleanup() {
+    releaseAtlas();
     if (stbFont_) {
         delete static_cast<stbtt_fontinfo*>(stbFont_);
         stbFont_ = nullptr;
     }
-    fontData_.clear();
+    fontData_.reset();
+    source_.clear();
+    sdf_.reset();
+    sdfScale_ = 0.0f;
+    glyphIndexDense_.clear();
+    glyphIndexSparse_.clear();
+    fallbackGlyphs_.clear();
     size_ = 0.0f;
     scale_ = 0.0f;
+    ascent_ = 0.0f;
+    lineHeight_ = 0.0f;
+    descent_ = 0.0f;
+    advanceTable_.clear();
+    kerningTable_.clear();
 }
 
-bool Font::loadFromFile(const std::string& filename, float size) {
+void Font::releaseAtlas() {
+    for (auto& page : atlasPages_) {
+        if (page.texture) {
+            SDL_DestroyTexture(page.texture);
+        }
+    }
+    atlasPages_.clear();
+    glyphs_.clear();
+}
+
+std::vector<SDL_Texture*> Font::getAtlasTextures() const {
+    std::vector<SDL_Texture*> textures;
+    for (const AtlasPage& page : atlasPages_) {
+        textures.push_back(page.texture);
+    }
+    if (sdf_) {
+        for (const AtlasPage& page : sdf_->pages) {
+            textures.push_back(page.texture);
+        }
+    }
+    return textures;
+}
+
+Font::SdfAtlas::~SdfAtlas() {
+    for (auto& page : pages) {
+        if (page.texture) {
+            SDL_DestroyTexture(page.texture);
+        }
+    }
+}
+
+bool Font::loadFromFile(const std::string& filename, float size, bool sdf) {
     cleanup();
 
     std::ifstream file(filename, std::ios::binary | std::ios::ate);
@@ -62,41 +142,431 @@ bool Font::loadFromFile(const std::string& filename, float size) {
     size_t fileSize = file.tellg();
     file.seekg(0, std::ios::beg);
 
-    fontData_.resize(fileSize);
-    if (!file.read(reinterpret_cast<char*>(fontData_.data()), fileSize)) {
+    auto data = std::make_shared<std::vector<unsigned char>>(fileSize);
+    if (!file.read(reinterpret_cast<char*>(data->data()), fileSize)) {
         cleanup();
         return false;
     }
+    fontData_ = std::move(data);
 
+    source_ = filename;
     size_ = size;
+    if (sdf) {
+        sdf_ = std::make_shared<SdfAtlas>();
+    }
     return initializeFont();
 }
 
-bool Font::loadFromMemory(const unsigned char* data, size_t size, float fontSize) {
+bool Font::loadFromMemory(const unsigned char* data, size_t size, float fontSize, bool sdf) {
     cleanup();
 
-    fontData_.assign(data, data + size);
+    fontData_ = std::make_shared<const std::vector<unsigned char>>(data, data + size);
     size_ = fontSize;
+    if (sdf) {
+        sdf_ = std::make_shared<SdfAtlas>();
+    }
+    return initializeFont();
+}
+
+bool Font::loadFromFont(const Font& face, float size) {
+    if (&face == this || !face.isLoaded()) {
+        return false;
+    }
+
+    cleanup();
+
+    fontData_ = face.fontData_;
+    source_ = face.source_;
+    sdf_ = face.sdf_;
+    size_ = size;
     return initializeFont();
 }
 
 bool Font::initializeFont() {
-    if (fontData_.empty()) {
+    if (!fontData_ || fontData_->empty()) {
         return false;
     }
 
     stbFont_ = new stbtt_fontinfo();
     auto* fontInfo = static_cast<stbtt_fontinfo*>(stbFont_);
 
-    if (!stbtt_InitFont(fontInfo, fontData_.data(), 0)) {
+    if (!stbtt_InitFont(fontInfo, fontData_->data(), 0)) {
         cleanup();
         return false;
     }
 
     scale_ = stbtt_ScaleForPixelHeight(fontInfo, size_);
+
+    int ascent, descent, lineGap;
+    stbtt_GetFontVMetrics(fontInfo, &ascent, &descent, &lineGap);
+    ascent_ = ascent * scale_;
+    lineHeight_ = (ascent - descent + lineGap) * scale_;
+    descent_ = descent * scale_;
+    if (sdf_) {
+        sdfScale_ = stbtt_ScaleForPixelHeight(fontInfo, SDF_SIZE);
+    }
+
+    buildMetricsTables();
     return true;
 }
 
+void Font::buildMetricsTables() {
+    auto* fontInfo = static_cast<stbtt_fontinfo*>(stbFont_);
+
+    int indices[METRICS_TABLE_SIZE];
+    advanceTable_.assign(METRICS_TABLE_SIZE, -1.0f);
+    for (uint32_t i = 0; i < METRICS_TABLE_SIZE; ++i) {
+        indices[i] = getGlyphIndex(METRICS_TABLE_FIRST + i);
+        if (indices[i] != 0) {
+            int advance, leftSideBearing;
+            stbtt_GetGlyphHMetrics(fontInfo, indices[i], &advance, &leftSideBearing);
+            advanceTable_[i] = advance * scale_;
+        }
+    }
+
+    kerningTable_.assign(METRICS_TABLE_SIZE * METRICS_TABLE_SIZE, 0.0f);
+    for (uint32_t first = 0; first < METRICS_TABLE_SIZE; ++first) {
+        if (indices[first] == 0) continue;
+        for (uint32_t second = 0; second < METRICS_TABLE_SIZE; ++second) {
+            if (indices[second] == 0) continue;
+            kerningTable_[first * METRICS_TABLE_SIZE + second] =
+                stbtt_GetGlyphKernAdvance(fontInfo, indices[first], indices[second]) * scale_;
+        }
+    }
+}
+
+uint32_t decodeUtf8(const std::string& text, size_t* index) {
+    const size_t i = *index;
+    const unsigned char lead = static_cast<unsigned char>(text[i]);
+    if (lead < 0x80) {
+        *index = i + 1;
+        return lead;
+    }
+
+    int length;
+    uint32_t codepoint;
+    uint32_t minimum;
+    if ((lead & 0xE0) == 0xC0) {
+        length = 2;
+        codepoint = lead & 0x1F;
+        minimum = 0x80;
+    } else if ((lead & 0xF0) == 0xE0) {
+        length = 3;
+        codepoint = lead & 0x0F;
+        minimum = 0x800;
+    } else if ((lead & 0xF8) == 0xF0) {
+        length = 4;
+        codepoint = lead & 0x07;
+        minimum = 0x10000;
+    } else {
+        *index = i + 1;
+        return 0xFFFD;
+    }
+
+    if (i + length > text.size()) {
+        *index = i + 1;
+        return 0xFFFD;
+    }
+    for (int k = 1; k < length; ++k) {
+        const unsigned char c = static_cast<unsigned char>(text[i + k]);
+        if ((c & 0xC0) != 0x80) {
+            *index = i + 1;
+            return 0xFFFD;
+        }
+        codepoint = (codepoint << 6) | (c & 0x3F);
+    }
+
+    // Overlong forms, surrogates and values past U+10FFFF are not valid scalar values
+    if (codepoint < minimum || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+        *index = i + 1;
+        return 0xFFFD;
+    }
+
+    *index = i + length;
+    return codepoint;
+}
+
+int Font::getGlyphIndex(uint32_t codepoint) const {
+    if (!isLoaded()) {
+        return 0;
+    }
+    auto* fontInfo = static_cast<const stbtt_fontinfo*>(stbFont_);
+
+    if (codepoint < DENSE_GLYPH_RANGE) {
+        if (glyphIndexDense_.empty()) {
+            glyphIndexDense_.assign(DENSE_GLYPH_RANGE, -1);
+        }
+        int& index = glyphIndexDense_[codepoint];
+        if (index < 0) {
+            index = stbtt_FindGlyphIndex(fontInfo, static_cast<int>(codepoint));
+        }
+        return index;
+    }
+
+    auto it = glyphIndexSparse_.find(codepoint);
+    if (it == glyphIndexSparse_.end()) {
+        it = glyphIndexSparse_.emplace(codepoint, stbtt_FindGlyphIndex(fontInfo, static_cast<int>(codepoint))).first;
+    }
+    return it->second;
+}
+
+void Font::setFallbacks(std::vector<Font*> fallbacks) {
+    std::erase(fallbacks, this);
+    fallbacks_ = std::move(fallbacks);
+    fallbackGlyphs_.clear();
+}
+
+const Font* Font::fontFor(uint32_t codepoint) const {
+    if (hasGlyph(codepoint)) {
+        return this;
+    }
+    for (const Font* fallback : fallbacks_) {
+        if (fallback->isLoaded() && fallback->hasGlyph(codepoint)) {
+            return fallback;
+        }
+    }
+    return this; // Missing everywhere, shows this font's .notdef glyph
+}
+
+float Font::getAdvance(uint32_t codepoint) const {
+    const uint32_t slot = codepoint - METRICS_TABLE_FIRST;
+    if (slot < METRICS_TABLE_SIZE && advanceTable_[slot] >= 0.0f) {
+        return advanceTable_[slot];
+    }
+
+    const Font* font = fontFor(codepoint);
+    int advance, leftSideBearing;
+    stbtt_GetGlyphHMetrics(static_cast<const stbtt_fontinfo*>(font->stbFont_), font->getGlyphIndex(codepoint),
+                           &advance, &leftSideBearing);
+    return advance * font->scale_;
+}
+
+float Font::getKerning(uint32_t first, uint32_t second) const {
+    if (!isLoaded()) {
+        return 0.0f;
+    }
+
+    const uint32_t firstSlot = first - METRICS_TABLE_FIRST;
+    const uint32_t secondSlot = second - METRICS_TABLE_FIRST;
+    if (firstSlot < METRICS_TABLE_SIZE && secondSlot < METRICS_TABLE_SIZE) {
+        return kerningTable_[firstSlot * METRICS_TABLE_SIZE + secondSlot];
+    }
+
+    // Only pairs that both come from this font have kerning data here
+    const int firstIndex = getGlyphIndex(first);
+    const int secondIndex = getGlyphIndex(second);
+    if (firstIndex == 0 || secondIndex == 0) {
+        return 0.0f;
+    }
+    auto* fontInfo = static_cast<const stbtt_fontinfo*>(stbFont_);
+    return stbtt_GetGlyphKernAdvance(fontInfo, firstIndex, secondIndex) * scale_;
+}
+
+const Glyph* Font::getGlyph(SDL_Renderer* renderer, uint32_t codepoint) {
+    auto it = glyphs_.find(codepoint);
+    if (it != glyphs_.end()) {
+        return &it->second;
+    }
+
+    if (!isLoaded() || !renderer) {
+        return nullptr;
+    }
+
+    if (!fallbacks_.empty() && !hasGlyph(codepoint)) {
+        auto borrowed = fallbackGlyphs_.find(codepoint);
+        if (borrowed != fallbackGlyphs_.end()) {
+            return borrowed->second;
+        }
+
+        const Font* provider = fontFor(codepoint);
+        if (provider != this) {
+            // The fallback rasterizes into its own atlas; only the pointer is kept here
+            const Glyph* glyph = const_cast<Font*>(provider)->getGlyph(renderer, codepoint);
+            fallbackGlyphs_[codepoint] = glyph;
+            return glyph;
+        }
+    }
+
+    Glyph glyph = sdf_ ? rasterizeSDFGlyph(renderer, codepoint) : rasterizeGlyph(renderer, codepoint);
+    return &glyphs_.emplace(codepoint, glyph).first->second;
+}
+
+Glyph Font::rasterizeGlyph(SDL_Renderer* renderer, uint32_t codepoint) {
+    auto* fontInfo = static_cast<stbtt_fontinfo*>(stbFont_);
+    const int index = getGlyphIndex(codepoint);
+
+    Glyph glyph;
+
+    int advance, leftSideBearing;
+    stbtt_GetGlyphHMetrics(fontInfo, index, &advance, &leftSideBearing);
+    glyph.advance = advance * scale_;
+
+    int ix0, iy0, ix1, iy1;
+    stbtt_GetGlyphBitmapBox(fontInfo, index, scale_, scale_, &ix0, &iy0, &ix1, &iy1);
+    int width = ix1 - ix0;
+    int height = iy1 - iy0;
+    if (width <= 0 || height <= 0) {
+        return glyph; // Nothing to draw, only advances the pen
+    }
+
+    int atlasX, atlasY;
+    AtlasPage* page = allocateAtlasRect(renderer, atlasPages_, width, height, &atlasX, &atlasY);
+    if (!page) {
+        return glyph;
+    }
+
+    // Rasterize coverage and expand it to white RGBA so the vertex color tints it
+    std::vector<unsigned char> coverage(static_cast<size_t>(width) * height);
+    stbtt_MakeGlyphBitmap(fontInfo, coverage.data(), width, height, width, scale_, scale_, index);
+
+    std::vector<Uint32> pixels(coverage.size());
+    for (size_t i = 0; i < coverage.size(); ++i) {
+        Uint8 alpha = coverage[i];
+        // RGBA8888: R=MSB, A=LSB
+        pixels[i] = 0xFFFFFF00u | alpha;
+    }
+
+    SDL_Rect rect = {atlasX, atlasY, width, height};
+    SDL_UpdateTexture(page->texture, &rect, pixels.data(), width * 4);
+
+    glyph.texture = page->texture;
+    glyph.x0 = static_cast<float>(ix0);
+    glyph.y0 = static_cast<float>(iy0);
+    glyph.x1 = static_cast<float>(ix1);
+    glyph.y1 = static_cast<float>(iy1);
+    glyph.u0 = static_cast<float>(atlasX) / page->width;
+    glyph.v0 = static_cast<float>(atlasY) / page->height;
+    glyph.u1 = static_cast<float>(atlasX + width) / page->width;
+    glyph.v1 = static_cast<float>(atlasY + height) / page->height;
+    return glyph;
+}
+
+// Glyph metrics come from this font's size; only the outline texture is shared between sizes
+Glyph Font::rasterizeSDFGlyph(SDL_Renderer* renderer, uint32_t codepoint) {
+    auto* fontInfo = static_cast<stbtt_fontinfo*>(stbFont_);
+    const int index = getGlyphIndex(codepoint);
+
+    Glyph glyph;
+
+    int advance, leftSideBearing;
+    stbtt_GetGlyphHMetrics(fontInfo, index, &advance, &leftSideBearing);
+    glyph.advance = advance * scale_;
+
+    auto it = sdf_->glyphs.find(index);
+    if (it == sdf_->glyphs.end()) {
+        it = sdf_->glyphs.emplace(index, bakeSDFGlyph(renderer, index)).first;
+    }
+
+    const SdfGlyph& baked = it->second;
+    if (!baked.texture) {
+        return glyph;
+    }
+
+    const float toSize = scale_ / sdfScale_;
+    glyph.texture = baked.texture;
+    glyph.x0 = baked.x0 * toSize;
+    glyph.y0 = baked.y0 * toSize;
+    glyph.x1 = baked.x1 * toSize;
+    glyph.y1 = baked.y1 * toSize;
+    glyph.u0 = baked.u0;
+    glyph.v0 = baked.v0;
+    glyph.u1 = baked.u1;
+    glyph.v1 = baked.v1;
+    return glyph;
+}
+
+// The renderer has no alpha test, so the field is shaped into a narrow alpha ramp around the
+// outline here and bilinear filtering reconstructs the edge at whatever size it is drawn
+Font::SdfGlyph Font::bakeSDFGlyph(SDL_Renderer* renderer, int index) {
+    auto* fontInfo = static_cast<stbtt_fontinfo*>(stbFont_);
+
+    SdfGlyph baked;
+    int width, height, xoff, yoff;
+    unsigned char* field = stbtt_GetGlyphSDF(fontInfo, sdfScale_, index, SDF_PADDING, SDF_ON_EDGE,
+                                             SDF_PIXEL_DIST_SCALE, &width, &height, &xoff, &yoff);
+    if (!field) {
+        return baked; // Blank glyph such as space
+    }
+
+    int atlasX, atlasY;
+    AtlasPage* page = allocateAtlasRect(renderer, sdf_->pages, width, height, &atlasX, &atlasY);
+    if (page) {
+        std::vector<Uint32> pixels(static_cast<size_t>(width) * height);
+        for (size_t i = 0; i < pixels.size(); ++i) {
+            // Signed distance to the outline in reference pixels, positive inside
+            const float distance = (static_cast<float>(field[i]) - SDF_ON_EDGE) / SDF_PIXEL_DIST_SCALE;
+            const float alpha = std::clamp(0.5f + distance / SDF_EDGE_WIDTH, 0.0f, 1.0f);
+            pixels[i] = 0xFFFFFF00u | static_cast<Uint32>(alpha * 255.0f + 0.5f);
+        }
+
+        SDL_Rect rect = {atlasX, atlasY, width, height};
+        SDL_UpdateTexture(page->texture, &rect, pixels.data(), width * 4);
+        SDL_SetTextureScaleMode(page->texture, SDL_SCALEMODE_LINEAR);
+
+        baked.texture = page->texture;
+        baked.x0 = static_cast<float>(xoff);
+        baked.y0 = static_cast<float>(yoff);
+        baked.x1 = static_cast<float>(xoff + width);
+        baked.y1 = static_cast<float>(yoff + height);
+        baked.u0 = static_cast<float>(atlasX) / page->width;
+        baked.v0 = static_cast<float>(atlasY) / page->height;
+        baked.u1 = static_cast<float>(atlasX + width) / page->width;
+        baked.v1 = static_cast<float>(atlasY + height) / page->height;
+    }
+
+    stbtt_FreeSDF(field, nullptr);
+    return baked;
+}
+
+Font::AtlasPage* Font::allocateAtlasRect(SDL_Renderer* renderer, std::vector<AtlasPage>& pages,
+                                         int width, int height, int* x, int* y) {
+    const int paddedWidth = width + ATLAS_PADDING;
+    const int paddedHeight = height + ATLAS_PADDING;
+
+    if (!pages.empty()) {
+        AtlasPage& page = pages.back();
+
+        // Start a new shelf when the current row is full
+        if (page.cursorX + paddedWidth > page.width) {
+            page.cursorX = ATLAS_PADDING;
+            page.cursorY += page.rowHeight;
+            page.rowHeight = 0;
+        }
+
+        if (page.cursorX + paddedWidth <= page.width && page.cursorY + paddedHeight <= page.height) {
+            *x = page.cursorX;
+            *y = page.cursorY;
+            page.cursorX += paddedWidth;
+            page.rowHeight = std::max(page.rowHeight, paddedHeight);
+            return &page;
+        }
+    }
+
+    // Current page is full (or there is none yet), open another one
+    AtlasPage page;
+    page.width = std::max(ATLAS_PAGE_SIZE, paddedWidth + ATLAS_PADDING);
+    page.height = std::max(ATLAS_PAGE_SIZE, paddedHeight + ATLAS_PADDING);
+    page.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC,
+                                     page.width, page.height);
+    if (!page.texture) {
+        return nullptr;
+    }
+    SDL_SetTextureBlendMode(page.texture, SDL_BLENDMODE_BLEND);
+
+    // Start from fully transparent so filtering at glyph edges doesn't pick up garbage
+    std::vector<Uint32> blank(static_cast<size_t>(page.width) * page.height, 0xFFFFFF00u);
+    SDL_UpdateTexture(page.texture, nullptr, blank.data(), page.width * 4);
+
+    page.cursorX = ATLAS_PADDING + paddedWidth;
+    page.cursorY = ATLAS_PADDING;
+    page.rowHeight = paddedHeight;
+    *x = ATLAS_PADDING;
+    *y = ATLAS_PADDING;
+
+    pages.push_back(page);
+    return &pages.back();
+}
+
 void Font::getTextSize(const std::string& text, int* width, int* height) const {
     if (!isLoaded() || text.empty()) {
         if (width) *width = 0;
@@ -104,27 +574,24 @@ void Font::getTextSize(const std::string& text, int* width, int* height) const {
         return;
     }
 
-    auto* fontInfo = static_cast<stbtt_fontinfo*>(stbFont_);
-
-    int ascent, descent, lineGap;
-    stbtt_GetFontVMetrics(fontInfo, &ascent, &descent, &lineGap);
-
     if (height) {
-        *height = static_cast<int>((ascent - descent) * scale_);
+        *height = static_cast<int>(ascent_ - descent_);
     }
 
     if (width) {
         float totalWidth = 0.0f;
-        for (size_t i = 0; i < text.length(); ++i) {
-            int advance, leftSideBearing;
-            stbtt_GetCodepointHMetrics(fontInfo, text[i], &advance, &leftSideBearing);
-            totalWidth += advance * scale_;
-
-            // Add kerning if not the last character
-            if (i < text.length() - 1) {
-                int kern = stbtt_GetCodepointKernAdvance(fontInfo, text[i], text[i + 1]);
-                totalWidth += kern * scale_;
+        size_t i = 0;
+        uint32_t codepoint = decodeUtf8(text, &i);
+        for (;;) {
+            totalWidth += getAdvance(codepoint);
+            if (i >= text.length()) {
+                break;
             }
+
+            // Add kerning with the next character
+            const uint32_t next = decodeUtf8(text, &i);
+            totalWidth += getKerning(codepoint, next);
+            codepoint = next;
         }
         *width = static_cast<int>(totalWidth);
     }
@@ -160,23 +627,21 @@ SDL_Texture* Font::renderText(SDL_Renderer* renderer, const std::string& text,
     int pitch = surface->pitch;
 
     auto* fontInfo = static_cast<stbtt_fontinfo*>(stbFont_);
-    int ascent, descent, lineGap;
-    stbtt_GetFontVMetrics(fontInfo, &ascent, &descent, &lineGap);
-
-    int baseline = static_cast<int>(ascent * scale_);
+    int baseline = static_cast<int>(ascent_);
     float x = 0.0f;
 
-    // Render each character
-    for (size_t i = 0; i < text.length(); ++i) {
-        char c = text[i];
+    // Render each character; fallback fonts are not consulted on this path
+    for (size_t i = 0; i < text.length();) {
+        const uint32_t c = decodeUtf8(text, &i);
+        const int index = getGlyphIndex(c);
 
         int advance, leftSideBearing;
-        stbtt_GetCodepointHMetrics(fontInfo, c, &advance, &leftSideBearing);
+        stbtt_GetGlyphHMetrics(fontInfo, index, &advance, &leftSideBearing);
 
         // Get character bitmap with proper scaling
         int width, height, xOffset, yOffset;
-        unsigned char* bitmap = stbtt_GetCodepointBitmap(fontInfo, scale_, scale_, c,
-                                                        &width, &height, &xOffset, &yOffset);
+        unsigned char* bitmap = stbtt_GetGlyphBitmap(fontInfo, scale_, scale_, index,
+                                                     &width, &height, &xOffset, &yOffset);
 
 
         if (bitmap) {
@@ -210,9 +675,10 @@ SDL_Texture* Font::renderText(SDL_Renderer* renderer, const std::string& text,
         x += advance * scale_;
 
         // Add kerning
-        if (i < text.length() - 1) {
-            int kern = stbtt_GetCodepointKernAdvance(fontInfo, c, text[i + 1]);
-            x += kern * scale_;
+        if (i < text.length()) {
+            size_t next = i;
+            const int nextIndex = getGlyphIndex(decodeUtf8(text, &next));
+            x += stbtt_GetGlyphKernAdvance(fontInfo, index, nextIndex) * scale_;
         }
     }
 
@@ -1,7 +1,14 @@
 #include "tsuki/graphics.hpp"
+#include "tsuki/camera.hpp"
+#include "tsuki/mesh.hpp"
+#include "tsuki/particle_system.hpp"
+#include "tsuki/shape.hpp"
+#include "tsuki/sprite_batch.hpp"
+#include "tsuki/tilemap.hpp"
 #include <algorithm>
 #include <cmath>
 #include <cstdio>
+#include <cstring>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
@@ -13,6 +20,14 @@
 
 namespace tsuki {
 
+namespace {
+
+SDL_FColor toFColor(const Color& color) {
+    return {color.r, color.g, color.b, color.a};
+}
+
+} // namespace
+
 // Image implementation
 Image::Image(const std::string& filename, SDL_Renderer* renderer) {
     load(filename, renderer);
@@ -23,10 +38,17 @@ Image::~Image() {
 }
 
 Image::Image(Image&& other) noexcept
-    : texture_(other.texture_), width_(other.width_), height_(other.height_) {
+    : texture_(other.texture_), width_(other.width_), height_(other.height_),
+      bounds_(other.bounds_), tex_coords_(other.tex_coords_),
+      atlas_(other.atlas_), atlas_page_(other.atlas_page_), standalone_(other.standalone_),
+      source_(std::move(other.source_)), evicted_(other.evicted_) {
     other.texture_ = nullptr;
+    other.standalone_ = nullptr;
     other.width_ = 0;
     other.height_ = 0;
+    other.atlas_ = nullptr;
+    other.atlas_page_ = -1;
+    other.evicted_ = false;
 }
 
 Image& Image::operator=(Image&& other) noexcept {
@@ -35,14 +57,25 @@ Image& Image::operator=(Image&& other) noexcept {
         texture_ = other.texture_;
         width_ = other.width_;
         height_ = other.height_;
+        bounds_ = other.bounds_;
+        tex_coords_ = other.tex_coords_;
+        atlas_ = other.atlas_;
+        atlas_page_ = other.atlas_page_;
+        standalone_ = other.standalone_;
+        source_ = std::move(other.source_);
+        evicted_ = other.evicted_;
         other.texture_ = nullptr;
+        other.standalone_ = nullptr;
         other.width_ = 0;
         other.height_ = 0;
+        other.atlas_ = nullptr;
+        other.atlas_page_ = -1;
+        other.evicted_ = false;
     }
     return *this;
 }
 
-bool Image::load(const std::string& filename, SDL_Renderer* renderer) {
+bool Image::load(const std::string& filename, SDL_Renderer* renderer, TextureAtlas* atlas) {
     unload();
 
     if (!renderer) {
@@ -57,33 +90,118 @@ bool Image::load(const std::string& filename, SDL_Renderer* renderer) {
         return false;
     }
 
+    const bool loaded = loadPixels(data, width, height, renderer, atlas);
+    stbi_image_free(data);
+    if (loaded) {
+        source_ = filename;
+    }
+    return loaded;
+}
+
+bool Image::loadPixels(const unsigned char* data, int width, int height, SDL_Renderer* renderer,
+                       TextureAtlas* atlas) {
+    unload();
+
+    if (!renderer || !data) {
+        return false;
+    }
+
     width_ = width;
     height_ = height;
 
-    // Create SDL surface from loaded data
-    SDL_Surface* surface = SDL_CreateSurfaceFrom(width, height, SDL_PIXELFORMAT_RGBA32, data, width * 4);
+    // Small images go into a shared atlas page, with fully transparent borders trimmed off
+    if (atlas && width <= TextureAtlas::MAX_IMAGE_SIZE && height <= TextureAtlas::MAX_IMAGE_SIZE) {
+        SDL_Rect trim = findOpaqueBounds(data, width, height);
+        const unsigned char* first = data + (static_cast<size_t>(trim.y) * width + trim.x) * 4;
+
+        TextureAtlas::Region region;
+        if (atlas->insert(renderer, first, trim.w, trim.h, width * 4, &region)) {
+            texture_ = region.texture;
+            atlas_ = atlas;
+            atlas_page_ = region.page;
+            bounds_ = {float(trim.x), float(trim.y), float(trim.w), float(trim.h)};
+            tex_coords_ = {
+                float(region.rect.x) / region.pageWidth,
+                float(region.rect.y) / region.pageHeight,
+                float(region.rect.x + region.rect.w) / region.pageWidth,
+                float(region.rect.y + region.rect.h) / region.pageHeight
+            };
+            return true;
+        }
+    }
+
+    // Create SDL surface from loaded data; SDL only reads from it here
+    SDL_Surface* surface = SDL_CreateSurfaceFrom(width, height, SDL_PIXELFORMAT_RGBA32,
+                                                 const_cast<unsigned char*>(data), width * 4);
     if (!surface) {
-        stbi_image_free(data);
         return false;
     }
 
     // Create texture from surface
     texture_ = SDL_CreateTextureFromSurface(renderer, surface);
+    bounds_ = {0.0f, 0.0f, float(width), float(height)};
+    tex_coords_ = {0.0f, 0.0f, 1.0f, 1.0f};
 
     // Clean up
     SDL_DestroySurface(surface);
-    stbi_image_free(data);
 
     return texture_ != nullptr;
 }
 
 void Image::unload() {
-    if (texture_) {
+    if (standalone_) {
+        SDL_DestroyTexture(standalone_);
+        standalone_ = nullptr;
+    }
+    if (atlas_) {
+        // The page belongs to the atlas, just give the space back
+        atlas_->release(atlas_page_, static_cast<int>(bounds_.w), static_cast<int>(bounds_.h));
+        atlas_ = nullptr;
+        atlas_page_ = -1;
+        texture_ = nullptr;
+    } else if (texture_) {
         SDL_DestroyTexture(texture_);
         texture_ = nullptr;
     }
     width_ = 0;
     height_ = 0;
+    bounds_ = {0.0f, 0.0f, 0.0f, 0.0f};
+    source_.clear();
+    evicted_ = false;
+}
+
+bool Image::evict() {
+    if (atlas_ || !texture_ || source_.empty()) {
+        return false;
+    }
+    SDL_DestroyTexture(texture_);
+    texture_ = nullptr;
+    evicted_ = true;
+    return true;
+}
+
+bool Image::restore(const unsigned char* pixels, int width, int height, SDL_Renderer* renderer) {
+    if (!evicted_) {
+        return isValid();
+    }
+
+    // Reloaded standalone, so the texture coordinates stay what batches already baked in
+    std::string source = std::move(source_);
+    if (!loadPixels(pixels, width, height, renderer, nullptr)) {
+        source_ = std::move(source);
+        evicted_ = true;
+        return false;
+    }
+    source_ = std::move(source);
+    return true;
+}
+
+size_t Image::getTextureBytes() const {
+    const size_t bytes = static_cast<size_t>(width_) * height_ * 4;
+    if (atlas_) {
+        return standalone_ ? bytes : 0;
+    }
+    return texture_ ? bytes : 0;
 }
 
 int Image::getWidth() const {
@@ -94,10 +212,118 @@ int Image::getHeight() const {
     return height_;
 }
 
+bool Image::mapRegion(const SDL_FRect& region, TextureQuad* quad) const {
+    // Clip the requested rect against the part of the image that has texels
+    const float x0 = std::max(region.x, bounds_.x);
+    const float y0 = std::max(region.y, bounds_.y);
+    const float x1 = std::min(region.x + region.w, bounds_.x + bounds_.w);
+    const float y1 = std::min(region.y + region.h, bounds_.y + bounds_.h);
+    if (x1 <= x0 || y1 <= y0) {
+        return false;
+    }
+
+    const float du = (tex_coords_.w - tex_coords_.x) / bounds_.w;
+    const float dv = (tex_coords_.h - tex_coords_.y) / bounds_.h;
+
+    quad->x0 = x0 - region.x;
+    quad->y0 = y0 - region.y;
+    quad->x1 = x1 - region.x;
+    quad->y1 = y1 - region.y;
+    quad->u0 = tex_coords_.x + (x0 - bounds_.x) * du;
+    quad->v0 = tex_coords_.y + (y0 - bounds_.y) * dv;
+    quad->u1 = tex_coords_.x + (x1 - bounds_.x) * du;
+    quad->v1 = tex_coords_.y + (y1 - bounds_.y) * dv;
+    return true;
+}
+
+SDL_Rect Image::findOpaqueBounds(const unsigned char* pixels, int width, int height) {
+    int minX = width, minY = height, maxX = -1, maxY = -1;
+    for (int y = 0; y < height; ++y) {
+        const unsigned char* row = pixels + static_cast<size_t>(y) * width * 4;
+        for (int x = 0; x < width; ++x) {
+            if (row[x * 4 + 3] != 0) {
+                minX = std::min(minX, x);
+                maxX = std::max(maxX, x);
+                minY = std::min(minY, y);
+                maxY = y;
+            }
+        }
+    }
+
+    // Keep a single texel for images that are entirely transparent
+    if (maxX < 0) {
+        return {0, 0, 1, 1};
+    }
+    return {minX, minY, maxX - minX + 1, maxY - minY + 1};
+}
+
+// Canvas implementation
+Canvas::Canvas(int width, int height, SDL_Renderer* renderer) {
+    create(renderer, width, height);
+}
+
+Canvas::~Canvas() {
+    release();
+}
+
+Canvas::Canvas(Canvas&& other) noexcept
+    : texture_(other.texture_), width_(other.width_), height_(other.height_), graphics_(other.graphics_) {
+    other.texture_ = nullptr;
+    other.width_ = 0;
+    other.height_ = 0;
+    other.graphics_ = nullptr;
+}
+
+Canvas& Canvas::operator=(Canvas&& other) noexcept {
+    if (this != &other) {
+        release();
+        texture_ = other.texture_;
+        width_ = other.width_;
+        height_ = other.height_;
+        graphics_ = other.graphics_;
+        other.texture_ = nullptr;
+        other.width_ = 0;
+        other.height_ = 0;
+        other.graphics_ = nullptr;
+    }
+    return *this;
+}
+
+bool Canvas::create(SDL_Renderer* renderer, int width, int height) {
+    release();
+
+    if (!renderer || width <= 0 || height <= 0) {
+        return false;
+    }
+
+    texture_ = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!texture_) {
+        return false;
+    }
+
+    SDL_SetTextureBlendMode(texture_, SDL_BLENDMODE_BLEND);
+    width_ = width;
+    height_ = height;
+    return true;
+}
+
+void Canvas::release() {
+    if (texture_) {
+        if (graphics_) {
+            graphics_->canvasReleased(this);
+        }
+        SDL_DestroyTexture(texture_);
+        texture_ = nullptr;
+    }
+    width_ = 0;
+    height_ = 0;
+}
+
 // Graphics implementation
 bool Graphics::init(SDL_Renderer* renderer) {
     renderer_ = renderer;
     current_color_ = Color::white();
+    invalidateRenderState();
 
     if (renderer_) {
         // Try to initialize a default system font
@@ -108,7 +334,27 @@ bool Graphics::init(SDL_Renderer* renderer) {
 }
 
 void Graphics::shutdown() {
+    discardBatch();
+    cancelImageLoads();
+
+    // Glyph and image atlases are renderer textures and must go before the renderer does
+    current_font_ = nullptr;
+    text_layouts_.clear();
+    fonts_.clear();
+    image_names_.clear();
+    image_slots_.clear();
+    free_image_slots_.clear();
+    image_atlas_.clear();
+
+    if (current_canvas_) {
+        SDL_SetRenderTarget(renderer_, nullptr);
+        current_canvas_ = nullptr;
+    }
+    canvas_pool_.clear();
+    scene_canvas_.release();
+
     renderer_ = nullptr;
+    invalidateRenderState();
 }
 
 void Graphics::clear() {
@@ -118,196 +364,317 @@ void Graphics::clear() {
 void Graphics::clear(const Color& color) {
     if (!renderer_) return;
 
-    SDL_SetRenderDrawColor(renderer_,
-        static_cast<Uint8>(color.r * 255),
-        static_cast<Uint8>(color.g * 255),
-        static_cast<Uint8>(color.b * 255),
-        static_cast<Uint8>(color.a * 255));
+    // Anything still queued would be painted over by the clear anyway
+    discardBatch();
+
+    // A new frame starts on the screen target, which may be the scene canvas
+    if (!current_canvas_) {
+        ensureSceneCanvas();
+        applyRenderTarget(screenTarget());
+    }
+
+    // The output may have been resized since the last frame
+    view_dirty_ = true;
+
+    applyDrawColor(color);
     SDL_RenderClear(renderer_);
 }
 
 void Graphics::present() {
     if (renderer_) {
+        // Always present the screen, even if a canvas was left bound
+        if (current_canvas_) {
+            setCanvas(nullptr);
+        }
+        flushBatch();
+        if (sceneActive() && scene_canvas_.isValid()) {
+            presentScene();
+        }
         SDL_RenderPresent(renderer_);
+        updateDynamicResolution();
+        processImageLoads();
+        enforceTextureBudget();
+        ++frame_index_;
+
+        last_frame_state_stats_ = state_stats_;
+        state_stats_ = {};
+        last_frame_queue_stats_ = queue_stats_;
+        queue_stats_ = {};
+        last_frame_cull_stats_ = cull_stats_;
+        cull_stats_ = {};
+    }
+}
+
+// Canvas management
+void Graphics::setCanvas(Canvas* canvas) {
+    if (!renderer_ || canvas == current_canvas_) return;
+
+    // Pending geometry belongs to the previous target
+    flushBatch();
+
+    applyRenderTarget((canvas && canvas->isValid()) ? canvas->getTexture() : screenTarget());
+    current_canvas_ = (canvas && canvas->isValid()) ? canvas : nullptr;
+}
+
+std::unique_ptr<Canvas> Graphics::newCanvas(int width, int height) {
+    auto canvas = std::make_unique<Canvas>();
+    if (!canvas->create(renderer_, width, height)) {
+        return nullptr;
+    }
+    canvas->graphics_ = this;
+    return canvas;
+}
+
+// Called while the canvas texture still exists
+void Graphics::canvasReleased(Canvas* canvas) {
+    if (!renderer_) return;
+
+    // Queued quads may sample the canvas, or be meant for it while it is the target
+    flushBatch();
+    if (canvas == current_canvas_) {
+        applyRenderTarget(screenTarget());
+        current_canvas_ = nullptr;
+    }
+    forgetTexture(canvas->getTexture());
+}
+
+Canvas* Graphics::acquireCanvas(int width, int height) {
+    if (!renderer_ || width <= 0 || height <= 0) return nullptr;
+
+    for (auto& entry : canvas_pool_) {
+        if (!entry.inUse && entry.canvas->getWidth() == width && entry.canvas->getHeight() == height) {
+            entry.inUse = true;
+            return entry.canvas.get();
+        }
+    }
+
+    auto canvas = std::make_unique<Canvas>();
+    if (!canvas->create(renderer_, width, height)) {
+        return nullptr;
+    }
+
+    canvas_pool_.push_back({std::move(canvas), true});
+    return canvas_pool_.back().canvas.get();
+}
+
+void Graphics::releaseCanvas(Canvas* canvas) {
+    if (!canvas) return;
+
+    if (canvas == current_canvas_) {
+        setCanvas(nullptr);
+    }
+
+    for (auto& entry : canvas_pool_) {
+        if (entry.canvas.get() == canvas) {
+            entry.inUse = false;
+            return;
+        }
     }
 }
 
 void Graphics::setColor(const Color& color) {
+    // Only recorded here; the SDL draw color is applied lazily by the calls that use it
     current_color_ = color;
+}
+
+void Graphics::setLineWidth(float width) {
+    line_width_ = std::fabs(width);
+}
+
+void Graphics::setScissor(int x, int y, int width, int height) {
+    scissor_enabled_ = true;
+    scissor_rect_ = {x, y, std::max(0, width), std::max(0, height)};
     if (renderer_) {
-        SDL_SetRenderDrawColor(renderer_,
-            static_cast<Uint8>(color.r * 255),
-            static_cast<Uint8>(color.g * 255),
-            static_cast<Uint8>(color.b * 255),
-            static_cast<Uint8>(color.a * 255));
+        applyScissor();
     }
 }
 
-void Graphics::rectangle(DrawMode mode, float x, float y, float width, float height) {
-    if (!renderer_) return;
+void Graphics::setScissor() {
+    scissor_enabled_ = false;
+    if (renderer_) {
+        applyScissor();
+    }
+}
 
-    setColor(current_color_);
+void Graphics::applyScissor() {
+    if (!scissor_enabled_) {
+        applyClipRect(nullptr);
+        return;
+    }
 
-    SDL_FRect rect = {x, y, width, height};
+    // The scissor is given in logical units, the scene canvas may be smaller
+    SDL_Rect rect = scissor_rect_;
+    if (drawingToScene()) {
+        rect = scaleRect(rect, render_scale_);
+    }
+    applyClipRect(&rect);
+}
 
-    if (mode == DrawMode::Fill) {
-        SDL_RenderFillRect(renderer_, &rect);
-    } else {
-        SDL_RenderRect(renderer_, &rect);
+bool Graphics::getScissor(SDL_Rect* rect) const {
+    if (scissor_enabled_ && rect) {
+        *rect = scissor_rect_;
     }
+    return scissor_enabled_;
 }
 
-void Graphics::circle(DrawMode mode, float x, float y, float radius, int segments) {
+void Graphics::rectangle(DrawMode mode, float x, float y, float width, float height) {
     if (!renderer_) return;
 
-    setColor(current_color_);
+    syncView();
+    const float pad = strokeExtent(mode);
+    if (isCulled(std::min(x, x + width) - pad, std::min(y, y + height) - pad,
+                 std::max(x, x + width) + pad, std::max(y, y + height) + pad)) {
+        return;
+    }
 
     if (mode == DrawMode::Fill) {
-        // Draw filled circle using triangle fan with SDL_RenderGeometry
-        std::vector<SDL_Vertex> vertices;
-        std::vector<int> indices;
-
-        // Center vertex
-        SDL_Vertex center;
-        center.position = {x, y};
-        center.color = {current_color_.r, current_color_.g, current_color_.b, current_color_.a};
-        center.tex_coord = {0.0f, 0.0f};
-        vertices.push_back(center);
-
-        // Generate circle vertices
-        for (int i = 0; i <= segments; ++i) {
-            float angle = (float(i) / segments) * 2.0f * M_PI;
-            SDL_Vertex v;
-            v.position = {x + radius * std::cos(angle), y + radius * std::sin(angle)};
-            v.color = center.color;
-            v.tex_coord = {0.0f, 0.0f};
-            vertices.push_back(v);
-        }
-
-        // Generate triangle fan indices
-        for (int i = 1; i < segments + 1; ++i) {
-            indices.push_back(0);      // center
-            indices.push_back(i);      // current vertex
-            indices.push_back(i + 1);  // next vertex
-        }
-
-        SDL_RenderGeometry(renderer_, nullptr, vertices.data(), vertices.size(),
-                          indices.data(), indices.size());
+        const SDL_FPoint positions[4] = {{x, y}, {x + width, y}, {x + width, y + height}, {x, y + height}};
+        const SDL_FPoint texCoords[4] = {{0.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 0.0f}};
+        batchQuad(nullptr, positions, texCoords, toFColor(current_color_));
+    } else if (transform_is_identity_ && !deferred_ && line_width_ == 1.0f) {
+        flushBatch();
+        applyDrawColor(current_color_);
+        SDL_FRect rect = {x, y, width, height};
+        SDL_RenderRect(renderer_, &rect);
     } else {
-        // Draw circle outline
-        std::vector<SDL_FPoint> points;
-        for (int i = 0; i <= segments; ++i) {
-            float angle = (float(i) / segments) * 2.0f * M_PI;
-            points.push_back({
-                x + radius * std::cos(angle),
-                y + radius * std::sin(angle)
-            });
-        }
-        SDL_RenderLines(renderer_, points.data(), points.size());
+        // A transformed rectangle may be rotated, so outline it as a closed path
+        SDL_FPoint corners[5] = {{x, y}, {x + width, y}, {x + width, y + height}, {x, y + height}, {x, y}};
+        transformPoints(corners, 5);
+        drawLineStrip(corners, 5);
     }
 }
 
+void Graphics::circle(DrawMode mode, float x, float y, float radius, int segments) {
+    ellipse(mode, x, y, radius, radius, segments);
+}
+
 void Graphics::ellipse(DrawMode mode, float x, float y, float rx, float ry, int segments) {
     if (!renderer_) return;
 
-    setColor(current_color_);
-
-    if (mode == DrawMode::Fill) {
-        // Draw filled ellipse using triangle fan with SDL_RenderGeometry
-        std::vector<SDL_Vertex> vertices;
-        std::vector<int> indices;
-
-        // Center vertex
-        SDL_Vertex center;
-        center.position = {x, y};
-        center.color = {current_color_.r, current_color_.g, current_color_.b, current_color_.a};
-        center.tex_coord = {0.0f, 0.0f};
-        vertices.push_back(center);
-
-        // Generate ellipse vertices
-        for (int i = 0; i <= segments; ++i) {
-            float angle = (float(i) / segments) * 2.0f * M_PI;
-            SDL_Vertex v;
-            v.position = {x + rx * std::cos(angle), y + ry * std::sin(angle)};
-            v.color = center.color;
-            v.tex_coord = {0.0f, 0.0f};
-            vertices.push_back(v);
-        }
+    syncView();
+    const float pad = strokeExtent(mode);
+    if (isCulled(x - std::fabs(rx) - pad, y - std::fabs(ry) - pad,
+                 x + std::fabs(rx) + pad, y + std::fabs(ry) + pad)) {
+        return;
+    }
 
-        // Generate triangle fan indices
-        for (int i = 1; i < segments + 1; ++i) {
-            indices.push_back(0);      // center
-            indices.push_back(i);      // current vertex
-            indices.push_back(i + 1);  // next vertex
-        }
+    if (segments <= 0) {
+        segments = autoSegments(std::max(std::fabs(rx), std::fabs(ry)));
+    }
 
-        SDL_RenderGeometry(renderer_, nullptr, vertices.data(), vertices.size(),
-                          indices.data(), indices.size());
+    if (mode == DrawMode::Fill) {
+        batchFan(x, y, rx, ry, 0.0f, 2.0f * M_PI, segments);
     } else {
-        std::vector<SDL_FPoint> points;
-        for (int i = 0; i <= segments; ++i) {
-            float angle = (float(i) / segments) * 2.0f * M_PI;
-            points.push_back({
-                x + rx * std::cos(angle),
-                y + ry * std::sin(angle)
-            });
-        }
-        SDL_RenderLines(renderer_, points.data(), points.size());
+        drawArcOutline(x, y, rx, ry, 0.0f, 2.0f * M_PI, segments);
     }
 }
 
 void Graphics::line(float x1, float y1, float x2, float y2) {
     if (!renderer_) return;
 
-    setColor(current_color_);
-    SDL_RenderLine(renderer_, x1, y1, x2, y2);
+    syncView();
+    const float pad = strokeExtent(DrawMode::Line);
+    if (isCulled(std::min(x1, x2) - pad, std::min(y1, y2) - pad, std::max(x1, x2) + pad, std::max(y1, y2) + pad)) {
+        return;
+    }
+
+    SDL_FPoint ends[2] = {{x1, y1}, {x2, y2}};
+    transformPoints(ends, 2);
+    drawLineStrip(ends, 2);
 }
 
 void Graphics::polygon(DrawMode mode, const std::vector<float>& points) {
     if (!renderer_ || points.size() < 6) return; // Need at least 3 points (6 coordinates)
 
-    setColor(current_color_);
+    syncView();
+
+    const size_t count = points.size() / 2;
 
-    std::vector<SDL_FPoint> sdl_points;
-    for (size_t i = 0; i < points.size(); i += 2) {
-        sdl_points.push_back({points[i], points[i + 1]});
+    float minX = points[0], minY = points[1], maxX = points[0], maxY = points[1];
+    for (size_t i = 1; i < count; ++i) {
+        minX = std::min(minX, points[i * 2]);
+        maxX = std::max(maxX, points[i * 2]);
+        minY = std::min(minY, points[i * 2 + 1]);
+        maxY = std::max(maxY, points[i * 2 + 1]);
     }
+    const float pad = strokeExtent(mode);
+    if (isCulled(minX - pad, minY - pad, maxX + pad, maxY + pad)) return;
 
     if (mode == DrawMode::Fill) {
-        // Use triangle fan rendering with SDL_RenderGeometry
-        std::vector<SDL_Vertex> vertices;
-        std::vector<int> indices;
+        // Triangle fan anchored at the first vertex
+        int base = reserveBatch(nullptr, count, (count - 2) * 3);
 
-        SDL_FColor color = {current_color_.r, current_color_.g, current_color_.b, current_color_.a};
-
-        // Convert points to vertices
-        for (const auto& point : sdl_points) {
-            SDL_Vertex v;
-            v.position = point;
-            v.color = color;
-            v.tex_coord = {0.0f, 0.0f};
-            vertices.push_back(v);
+        SDL_FColor color = toFColor(current_color_);
+        for (size_t i = 0; i < count; ++i) {
+            batch_vertices_.push_back({{points[i * 2], points[i * 2 + 1]}, color, {0.0f, 0.0f}});
         }
-
-        // Generate triangle fan indices
-        for (size_t i = 1; i < vertices.size() - 1; ++i) {
-            indices.push_back(0);      // first vertex
-            indices.push_back(i);      // current vertex
-            indices.push_back(i + 1);  // next vertex
+        transformVertices(&batch_vertices_[base], count);
+        for (size_t i = 1; i < count - 1; ++i) {
+            batch_indices_.push_back(base);
+            batch_indices_.push_back(base + static_cast<int>(i));
+            batch_indices_.push_back(base + static_cast<int>(i) + 1);
+        }
+    } else {
+        scratch_points_.resize(count + 1);
+        for (size_t i = 0; i < count; ++i) {
+            scratch_points_[i] = {points[i * 2], points[i * 2 + 1]};
         }
+        scratch_points_[count] = scratch_points_[0]; // Close the polygon
+        transformPoints(scratch_points_.data(), count + 1);
+        drawLineStrip(scratch_points_.data(), count + 1);
+    }
+}
+
+void Graphics::polygon(DrawMode mode, const Shape& shape) {
+    const auto& points = shape.getPoints();
+    if (!renderer_ || points.size() < 3) return;
+
+    syncView();
 
-        SDL_RenderGeometry(renderer_, nullptr, vertices.data(), vertices.size(),
-                          indices.data(), indices.size());
+    float minX, minY, maxX, maxY;
+    shape.getBounds(&minX, &minY, &maxX, &maxY);
+    const float pad = strokeExtent(mode);
+    if (isCulled(minX - pad, minY - pad, maxX + pad, maxY + pad)) return;
+
+    if (mode == DrawMode::Fill) {
+        const auto& triangles = shape.getTriangles();
+        if (triangles.empty()) return;
+
+        int base = reserveBatch(nullptr, points.size(), triangles.size());
+        SDL_FColor color = toFColor(current_color_);
+        for (const SDL_FPoint& point : points) {
+            batch_vertices_.push_back({point, color, {0.0f, 0.0f}});
+        }
+        transformVertices(&batch_vertices_[base], points.size());
+        for (int index : triangles) {
+            batch_indices_.push_back(base + index);
+        }
     } else {
-        sdl_points.push_back(sdl_points[0]); // Close the polygon
-        SDL_RenderLines(renderer_, sdl_points.data(), sdl_points.size());
+        // Outline and holes as separate closed strips
+        const auto& starts = shape.getContourStarts();
+        for (size_t c = 0; c < starts.size(); ++c) {
+            const size_t start = starts[c];
+            const size_t end = (c + 1 < starts.size()) ? starts[c + 1] : points.size();
+            if (end - start < 2) continue;
+
+            scratch_points_.assign(points.begin() + start, points.begin() + end);
+            scratch_points_.push_back(points[start]);
+            transformPoints(scratch_points_.data(), scratch_points_.size());
+            drawLineStrip(scratch_points_.data(), scratch_points_.size());
+        }
     }
 }
 
 void Graphics::arc(DrawMode mode, float x, float y, float radius, float angle1, float angle2, int segments) {
     if (!renderer_) return;
 
-    setColor(current_color_);
+    syncView();
+    const float r = std::fabs(radius) + strokeExtent(mode);
+    if (isCulled(x - r, y - r, x + r, y + r)) return;
+
+    if (segments <= 0) {
+        segments = autoSegments(std::fabs(radius));
+    }
 
     float angle_range = angle2 - angle1;
     float abs_angle_range = std::fabs(angle_range);
@@ -315,165 +682,451 @@ void Graphics::arc(DrawMode mode, float x, float y, float radius, float angle1,
     int actual_segments = std::max(1, calculated_segments);
 
     if (mode == DrawMode::Fill) {
-        // Draw filled arc using triangle fan with SDL_RenderGeometry
-        std::vector<SDL_Vertex> vertices;
-        std::vector<int> indices;
-
-        // Center vertex
-        SDL_Vertex center;
-        center.position = {x, y};
-        center.color = {current_color_.r, current_color_.g, current_color_.b, current_color_.a};
-        center.tex_coord = {0.0f, 0.0f};
-        vertices.push_back(center);
-
-        // Generate arc vertices
-        for (int i = 0; i <= actual_segments; ++i) {
-            float angle = angle1 + (float(i) / actual_segments) * angle_range;
-            SDL_Vertex v;
-            v.position = {x + radius * std::cos(angle), y + radius * std::sin(angle)};
-            v.color = center.color;
-            v.tex_coord = {0.0f, 0.0f};
-            vertices.push_back(v);
-        }
-
-        // Generate triangle fan indices
-        for (int i = 1; i < actual_segments + 1; ++i) {
-            indices.push_back(0);      // center
-            indices.push_back(i);      // current vertex
-            indices.push_back(i + 1);  // next vertex
-        }
-
-        SDL_RenderGeometry(renderer_, nullptr, vertices.data(), vertices.size(),
-                          indices.data(), indices.size());
+        batchFan(x, y, radius, radius, angle1, angle_range, actual_segments);
     } else {
-        std::vector<SDL_FPoint> points;
-        for (int i = 0; i <= actual_segments; ++i) {
-            float angle = angle1 + (float(i) / actual_segments) * angle_range;
-            points.push_back({
-                x + radius * std::cos(angle),
-                y + radius * std::sin(angle)
-            });
-        }
-        SDL_RenderLines(renderer_, points.data(), points.size());
+        drawArcOutline(x, y, radius, radius, angle1, angle_range, actual_segments);
     }
 }
 
 void Graphics::point(float x, float y) {
     if (!renderer_) return;
 
-    setColor(current_color_);
-    SDL_RenderPoint(renderer_, x, y);
+    syncView();
+
+    SDL_FPoint p = {x, y};
+    transformPoints(&p, 1);
+    drawPoints(&p, 1);
 }
 
 void Graphics::points(const std::vector<float>& points) {
-    if (!renderer_) return;
+    this->points(points.data(), points.size() / 2);
+}
 
-    setColor(current_color_);
+// Bulk primitives: coordinates are flat x, y pairs and each call is a single SDL submission
+void Graphics::points(const float* coords, size_t count) {
+    if (!renderer_ || !coords || count == 0) return;
 
-    for (size_t i = 0; i < points.size(); i += 2) {
-        SDL_RenderPoint(renderer_, points[i], points[i + 1]);
-    }
+    syncView();
+
+    const SDL_FPoint* points = loadScratchPoints(coords, count);
+    drawPoints(points, count);
 }
 
-void Graphics::draw(const Image& image, float x, float y) {
-    draw(image, x, y, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f);
+void Graphics::lines(const float* coords, size_t count) {
+    if (!renderer_ || !coords || count < 2) return;
+
+    syncView();
+
+    const SDL_FPoint* points = loadScratchPoints(coords, count);
+    drawLineStrip(points, count);
 }
 
-void Graphics::draw(const Image& image, float x, float y, float rotation, float sx, float sy, float ox, float oy) {
-    if (!renderer_ || !image.isValid()) return;
+void Graphics::polyline(const float* coords, size_t count) {
+    if (!renderer_ || !coords || count < 2) return;
 
-    SDL_FRect dest = {x - ox * sx, y - oy * sy, image.getWidth() * sx, image.getHeight() * sy};
-    SDL_FPoint center = {ox * sx, oy * sy};
+    syncView();
 
-    SDL_RenderTextureRotated(renderer_, image.getTexture(), nullptr, &dest, double(rotation * 180.0f / M_PI), &center, SDL_FLIP_NONE);
+    const SDL_FPoint* points = loadScratchPoints(coords, count);
+    strokeLineStrip(points, count);
 }
 
-void Graphics::print(const std::string& text, float x, float y) {
-    if (!renderer_ || text.empty()) {
+void Graphics::rectangles(DrawMode mode, const float* rects, size_t count) {
+    if (!renderer_ || !rects || count == 0) return;
+
+    syncView();
+
+    if (mode == DrawMode::Fill && (!transform_is_identity_ || deferred_)) {
+        // Rotated or skewed rectangles become quads in the batch
+        const SDL_FPoint texCoords[4] = {{0.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 0.0f}};
+        const SDL_FColor color = toFColor(current_color_);
+        for (size_t i = 0; i < count; ++i) {
+            const float* r = rects + i * 4;
+            const SDL_FPoint positions[4] = {
+                {r[0], r[1]}, {r[0] + r[2], r[1]}, {r[0] + r[2], r[1] + r[3]}, {r[0], r[1] + r[3]}
+            };
+            batchQuad(nullptr, positions, texCoords, color);
+        }
         return;
     }
 
-    // If we have a font loaded, use the proper font system
-    if (current_font_) {
-        // Render text using the Font system
-        Uint8 r = static_cast<Uint8>(current_color_.r * 255);
-        Uint8 g = static_cast<Uint8>(current_color_.g * 255);
-        Uint8 b = static_cast<Uint8>(current_color_.b * 255);
-        Uint8 a = static_cast<Uint8>(current_color_.a * 255);
-
-        SDL_Texture* textTexture = current_font_->renderText(renderer_, text, r, g, b, a);
-        if (!textTexture) {
-            // If custom font fails, fall back to SDL debug font
-            SDL_SetRenderDrawColor(renderer_, r, g, b, a);
-            SDL_RenderDebugText(renderer_, x, y, text.c_str());
-            return;
+    if (mode == DrawMode::Line && (!transform_is_identity_ || deferred_ || line_width_ != 1.0f)) {
+        // Outlines as closed paths, one line strip per rectangle
+        for (size_t i = 0; i < count; ++i) {
+            const float* r = rects + i * 4;
+            SDL_FPoint corners[5] = {
+                {r[0], r[1]}, {r[0] + r[2], r[1]}, {r[0] + r[2], r[1] + r[3]}, {r[0], r[1] + r[3]}, {r[0], r[1]}
+            };
+            transformPoints(corners, 5);
+            drawLineStrip(corners, 5);
         }
+        return;
+    }
 
-        // Get texture dimensions
-        float textWidth, textHeight;
-        SDL_GetTextureSize(textTexture, &textWidth, &textHeight);
+    scratch_rects_.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        scratch_rects_[i] = {rects[i * 4], rects[i * 4 + 1], rects[i * 4 + 2], rects[i * 4 + 3]};
+    }
 
+    flushBatch();
+    applyDrawColor(current_color_);
+    if (mode == DrawMode::Fill) {
+        SDL_RenderFillRects(renderer_, scratch_rects_.data(), static_cast<int>(count));
+    } else {
+        SDL_RenderRects(renderer_, scratch_rects_.data(), static_cast<int>(count));
+    }
+}
 
-        // Set destination rectangle
-        SDL_FRect destRect = {x, y, textWidth, textHeight};
+void Graphics::triangles(const float* coords, size_t count) {
+    if (!renderer_ || !coords || count == 0) return;
 
-        // Render the texture
-        SDL_RenderTexture(renderer_, textTexture, nullptr, &destRect);
+    syncView();
 
-        // Clean up
-        SDL_DestroyTexture(textTexture);
-    } else {
-        // Use SDL3's built-in debug font as default - never use fallback text
-        Uint8 r = static_cast<Uint8>(current_color_.r * 255);
-        Uint8 g = static_cast<Uint8>(current_color_.g * 255);
-        Uint8 b = static_cast<Uint8>(current_color_.b * 255);
-        Uint8 a = static_cast<Uint8>(current_color_.a * 255);
+    const size_t vertexCount = count * 3;
+    const SDL_FColor color = toFColor(current_color_);
+
+    // Large lists are split so a single call never overflows the batch
+    size_t first = 0;
+    while (first < vertexCount) {
+        const size_t run = std::min(vertexCount - first, (MAX_BATCH_VERTICES / 3) * 3);
+        int base = reserveBatch(nullptr, run, run);
 
-        SDL_SetRenderDrawColor(renderer_, r, g, b, a);
-        SDL_RenderDebugText(renderer_, x, y, text.c_str());
+        for (size_t i = 0; i < run; ++i) {
+            const float* v = coords + (first + i) * 2;
+            batch_vertices_.push_back({{v[0], v[1]}, color, {0.0f, 0.0f}});
+            batch_indices_.push_back(base + static_cast<int>(i));
+        }
+        transformVertices(&batch_vertices_[base], run);
+        first += run;
     }
 }
 
-// Font management functions
-bool Graphics::loadFont(const std::string& name, const std::string& filename, float size) {
-    auto font = std::make_unique<Font>();
-    if (!font->loadFromFile(filename, size)) {
-        return false;
-    }
+const SDL_FPoint* Graphics::loadScratchPoints(const float* coords, size_t count) {
+    static_assert(sizeof(SDL_FPoint) == 2 * sizeof(float), "SDL_FPoint must be a plain x, y pair");
+    scratch_points_.resize(count);
+    std::memcpy(scratch_points_.data(), coords, count * sizeof(SDL_FPoint));
+    transformPoints(scratch_points_.data(), count);
+    return scratch_points_.data();
+}
 
-    fonts_[name] = std::move(font);
-    return true;
+void Graphics::draw(const Image& image, float x, float y) {
+    draw(image, x, y, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f);
 }
 
-bool Graphics::setFont(const std::string& name) {
-    auto it = fonts_.find(name);
-    if (it != fonts_.end()) {
-        current_font_ = it->second.get();
-        return true;
-    }
-    return false;
+void Graphics::draw(const Image& image, float x, float y, float rotation, float sx, float sy, float ox, float oy) {
+    if (!renderer_ || !useImage(&image)) return;
+
+    syncView();
+
+    TextureQuad quad;
+    const SDL_FRect whole = {0.0f, 0.0f, float(image.getWidth()), float(image.getHeight())};
+    if (!image.mapRegion(whole, &quad)) return;
+
+    drawTexture(image.getTexture(), quad, x, y, rotation, sx, sy, ox, oy);
 }
 
-void Graphics::setDefaultFont() {
-    current_font_ = nullptr;
-    // Try to set to a default font if one exists
-    auto it = fonts_.find("default");
-    if (it != fonts_.end()) {
-        current_font_ = it->second.get();
-    }
+void Graphics::draw(const Canvas& canvas, float x, float y) {
+    draw(canvas, x, y, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f);
 }
 
-bool Graphics::initializeDefaultFont() {
-    // Try to load a system font as default
-    std::vector<std::string> systemFontPaths = {
-        "/usr/share/fonts/noto/NotoSans-Regular.ttf",           // Noto Sans (most common)
-        "/usr/share/fonts/TTF/DejaVuSans.ttf",                 // DejaVu Sans
-        "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",     // DejaVu Sans (Ubuntu)
-        "/usr/share/fonts/TTF/LiberationSans-Regular.ttf",     // Liberation Sans
-        "/usr/share/fonts/liberation/LiberationSans-Regular.ttf", // Liberation Sans (alt path)
-        "/System/Library/Fonts/Arial.ttf",                     // macOS
-        "C:\\Windows\\Fonts\\arial.ttf"                        // Windows
-    };
+void Graphics::draw(const Canvas& canvas, float x, float y, float rotation, float sx, float sy, float ox, float oy) {
+    if (!renderer_ || !canvas.isValid()) return;
+
+    syncView();
+
+    const TextureQuad quad = {0.0f, 0.0f, float(canvas.getWidth()), float(canvas.getHeight()),
+                              0.0f, 0.0f, 1.0f, 1.0f};
+    drawTexture(canvas.getTexture(), quad, x, y, rotation, sx, sy, ox, oy);
+}
+
+void Graphics::drawTexture(SDL_Texture* texture, const TextureQuad& quad, float x, float y,
+                           float rotation, float sx, float sy, float ox, float oy) {
+    // Corners relative to the origin point, scaled and then rotated around (x, y)
+    const float left = (quad.x0 - ox) * sx;
+    const float top = (quad.y0 - oy) * sy;
+    const float right = (quad.x1 - ox) * sx;
+    const float bottom = (quad.y1 - oy) * sy;
+
+    const float c = std::cos(rotation);
+    const float s = std::sin(rotation);
+    auto place = [&](float px, float py) -> SDL_FPoint {
+        return {x + px * c - py * s, y + px * s + py * c};
+    };
+
+    const SDL_FPoint positions[4] = {place(left, top), place(right, top), place(right, bottom), place(left, bottom)};
+    if (isCulled(positions, 4)) return;
+
+    const SDL_FPoint texCoords[4] = {{quad.u0, quad.v0}, {quad.u1, quad.v0}, {quad.u1, quad.v1}, {quad.u0, quad.v1}};
+
+    // Images and canvases are not tinted by the current color
+    batchQuad(texture, positions, texCoords, {1.0f, 1.0f, 1.0f, 1.0f});
+}
+
+void Graphics::draw(SpriteBatch& batch, float x, float y) {
+    const Image* image = getImage(batch.getImage());
+    if (!renderer_ || batch.getCount() == 0 || !useImage(image)) return;
+
+    syncView();
+
+    // Only sprites changed since the last draw are written; culling then skips the submission
+    const auto& vertices = batch.buildVertices(*image);
+    const auto& indices = batch.getIndices();
+
+    float x0, y0, x1, y1;
+    batch.getBounds(&x0, &y0, &x1, &y1);
+    if (x0 > x1 || isCulled(x0 + x, y0 + y, x1 + x, y1 + y)) return;
+
+    if (x == 0.0f && y == 0.0f) {
+        submitGeometry(image->getTexture(), vertices.data(), vertices.size(), indices.data(), indices.size());
+        return;
+    }
+
+    push();
+    translate(x, y);
+    submitGeometry(image->getTexture(), vertices.data(), vertices.size(), indices.data(), indices.size());
+    pop();
+}
+
+void Graphics::draw(const Mesh& mesh, float x, float y) {
+    if (!renderer_ || mesh.getIndices().empty()) return;
+
+    SDL_Texture* texture = nullptr;
+    if (mesh.getImage()) {
+        Image* image = getImage(mesh.getImage());
+        if (!useImage(image) || !(texture = standaloneTexture(*image))) return;
+    }
+
+    syncView();
+
+    // Offsetting goes through the transform so the retained vertices stay untouched
+    const bool offset = x != 0.0f || y != 0.0f;
+    if (offset) {
+        push();
+        translate(x, y);
+    }
+
+    float x0, y0, x1, y1;
+    mesh.getBounds(&x0, &y0, &x1, &y1);
+    if (!isCulled(x0, y0, x1, y1)) {
+        const auto& vertices = mesh.getVertices();
+        const auto& indices = mesh.getIndices();
+        submitGeometry(texture, vertices.data(), vertices.size(), indices.data(), indices.size());
+    }
+
+    if (offset) {
+        pop();
+    }
+}
+
+void Graphics::draw(Tilemap& tilemap, float x, float y, int layer) {
+    const Image* tileset = getImage(tilemap.getTileset());
+    if (!renderer_ || !useImage(tileset)) return;
+
+    syncView();
+
+    push();
+    translate(x, y);
+
+    // Only chunks overlapping the render target, in map space, are submitted
+    float x0, y0, x1, y1;
+    if (getVisibleBounds(&x0, &y0, &x1, &y1)) {
+        auto submit = [&](const std::vector<SDL_Vertex>& vertices, const std::vector<int>& indices) {
+            submitGeometry(tileset->getTexture(), vertices.data(), vertices.size(), indices.data(), indices.size());
+        };
+
+        if (layer >= 0) {
+            tilemap.forEachVisibleChunk(*tileset, layer, x0, y0, x1, y1, submit);
+        } else {
+            for (int l = 0; l < tilemap.getLayerCount(); ++l) {
+                tilemap.forEachVisibleChunk(*tileset, l, x0, y0, x1, y1, submit);
+            }
+        }
+    }
+
+    pop();
+}
+
+void Graphics::draw(ParticleSystem& particles, float x, float y) {
+    if (!renderer_ || particles.getCount() == 0) return;
+
+    // A system with an image draws nothing once that image is gone rather than falling back to flat quads
+    const Image* image = nullptr;
+    if (particles.getImage()) {
+        image = getImage(particles.getImage());
+        if (!useImage(image)) return;
+    }
+
+    syncView();
+
+    float x0, y0, x1, y1;
+    particles.getBounds(&x0, &y0, &x1, &y1);
+    if (isCulled(x0 + x, y0 + y, x1 + x, y1 + y)) return;
+
+    SDL_Texture* texture = image ? image->getTexture() : nullptr;
+    const auto& vertices = particles.buildVertices(image);
+    const auto& indices = particles.getIndices();
+    const size_t indexCount = particles.getCount() * 6;
+
+    if (x == 0.0f && y == 0.0f) {
+        submitGeometry(texture, vertices.data(), vertices.size(), indices.data(), indexCount);
+        return;
+    }
+
+    push();
+    translate(x, y);
+    submitGeometry(texture, vertices.data(), vertices.size(), indices.data(), indexCount);
+    pop();
+}
+
+void Graphics::print(const std::string& text, float x, float y) {
+    if (!renderer_ || text.empty()) {
+        return;
+    }
+
+    syncView();
+
+    // If we have a font loaded, emit one textured quad per glyph from its atlas
+    if (current_font_ && current_font_->isLoaded()) {
+        // Measuring only sums advances; glyphs may overhang them, which a line height of slack covers
+        int width = 0, height = 0;
+        current_font_->getTextSize(text, &width, &height);
+        if (isCulled(x - height, y - height, x + width + height, y + 2 * height)) return;
+
+        SDL_FColor color = toFColor(current_color_);
+        float penX = x;
+        float baseline = y + current_font_->getAscent();
+
+        size_t i = 0;
+        while (i < text.length()) {
+            const uint32_t codepoint = decodeUtf8(text, &i);
+            const Glyph* glyph = current_font_->getGlyph(renderer_, codepoint);
+            if (!glyph) {
+                continue;
+            }
+
+            if (glyph->texture) {
+                const SDL_FPoint positions[4] = {
+                    {penX + glyph->x0, baseline + glyph->y0}, {penX + glyph->x1, baseline + glyph->y0},
+                    {penX + glyph->x1, baseline + glyph->y1}, {penX + glyph->x0, baseline + glyph->y1}
+                };
+                const SDL_FPoint texCoords[4] = {
+                    {glyph->u0, glyph->v0}, {glyph->u1, glyph->v0},
+                    {glyph->u1, glyph->v1}, {glyph->u0, glyph->v1}
+                };
+                batchQuad(glyph->texture, positions, texCoords, color);
+            }
+
+            penX += glyph->advance;
+            if (i < text.length()) {
+                size_t next = i;
+                penX += current_font_->getKerning(codepoint, decodeUtf8(text, &next));
+            }
+        }
+    } else {
+        // Use SDL3's built-in debug font as default - never use fallback text
+        // The debug font can't be scaled or rotated, only its position follows the transform
+        SDL_FPoint p = {x, y};
+        transformPoints(&p, 1);
+
+        flushBatch();
+        applyDrawColor(current_color_);
+        SDL_RenderDebugText(renderer_, p.x, p.y, text.c_str());
+    }
+}
+
+// Font management functions
+bool Graphics::loadFont(const std::string& name, const std::string& filename, float size, bool sdf) {
+    const Font* face = nullptr;
+    if (sdf) {
+        for (const auto& [loaded_name, loaded] : fonts_) {
+            if (loaded->isSDF() && loaded->getSource() == filename) {
+                face = loaded.get();
+                break;
+            }
+        }
+    }
+
+    auto font = std::make_unique<Font>();
+    const bool loaded = face ? font->loadFromFont(*face, size) : font->loadFromFile(filename, size, sdf);
+    if (!loaded) {
+        return false;
+    }
+
+    // Queued glyph quads still sample the old font's atlas pages, and a replaced font may
+    // leave its address to the new one, so cached layouts must go
+    flushBatch();
+    text_layouts_.clear();
+    std::unique_ptr<Font>& slot = fonts_[name];
+    if (slot) {
+        for (SDL_Texture* texture : slot->getAtlasTextures()) {
+            forgetTexture(texture);
+        }
+        if (current_font_ == slot.get()) {
+            current_font_ = font.get();
+        }
+    }
+    slot = std::move(font);
+    resolveFontFallbacks();
+    return true;
+}
+
+bool Graphics::setFontFallbacks(const std::string& name, const std::vector<std::string>& fallbacks) {
+    if (fonts_.find(name) == fonts_.end()) {
+        return false;
+    }
+
+    // Layouts hold glyphs borrowed from the previous chain
+    text_layouts_.clear();
+    font_fallbacks_[name] = fallbacks;
+    resolveFontFallbacks();
+    return true;
+}
+
+// Chains are stored by name and re-resolved whenever a font is (re)loaded
+void Graphics::resolveFontFallbacks() {
+    for (const auto& [name, fallbacks] : font_fallbacks_) {
+        auto it = fonts_.find(name);
+        if (it == fonts_.end()) continue;
+
+        std::vector<Font*> chain;
+        for (const std::string& fallback : fallbacks) {
+            auto found = fonts_.find(fallback);
+            if (found != fonts_.end()) {
+                chain.push_back(found->second.get());
+            }
+        }
+        it->second->setFallbacks(std::move(chain));
+    }
+}
+
+bool Graphics::setFont(const std::string& name) {
+    auto it = fonts_.find(name);
+    if (it != fonts_.end()) {
+        current_font_ = it->second.get();
+        return true;
+    }
+    return false;
+}
+
+void Graphics::setDefaultFont() {
+    current_font_ = nullptr;
+    // Try to set to a default font if one exists
+    auto it = fonts_.find("default");
+    if (it != fonts_.end()) {
+        current_font_ = it->second.get();
+    }
+}
+
+bool Graphics::initializeDefaultFont() {
+    // Try to load a system font as default
+    std::vector<std::string> systemFontPaths = {
+        "/usr/share/fonts/noto/NotoSans-Regular.ttf",           // Noto Sans (most common)
+        "/usr/share/fonts/TTF/DejaVuSans.ttf",                 // DejaVu Sans
+        "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",     // DejaVu Sans (Ubuntu)
+        "/usr/share/fonts/TTF/LiberationSans-Regular.ttf",     // Liberation Sans
+        "/usr/share/fonts/liberation/LiberationSans-Regular.ttf", // Liberation Sans (alt path)
+        "/System/Library/Fonts/Arial.ttf",                     // macOS
+        "C:\\Windows\\Fonts\\arial.ttf"                        // Windows
+    };
 
     for (const auto& fontPath : systemFontPaths) {
         if (loadFont("default", fontPath, 32.0f)) {  // Larger size for better readability
@@ -487,35 +1140,335 @@ bool Graphics::initializeDefaultFont() {
 }
 
 // Image management functions
-bool Graphics::loadImage(const std::string& name, const std::string& filename) {
+ImageHandle Graphics::loadImage(const std::string& name, const std::string& filename) {
     if (!renderer_) {
-        return false;
+        return {};
     }
 
     auto image = std::make_unique<Image>();
-    if (!image->load(filename, renderer_)) {
+    if (!image->load(filename, renderer_, &image_atlas_)) {
+        return {};
+    }
+
+    return addImage(name, std::move(image));
+}
+
+ImageHandle Graphics::addImage(const std::string& name, std::unique_ptr<Image> image) {
+    // Replacing a name frees the old slot, so stale handles to it stop resolving
+    unloadImage(name);
+
+    uint32_t index;
+    if (!free_image_slots_.empty()) {
+        index = free_image_slots_.back();
+        free_image_slots_.pop_back();
+    } else {
+        index = static_cast<uint32_t>(image_slots_.size());
+        image_slots_.emplace_back();
+    }
+
+    ImageSlot& slot = image_slots_[index];
+    slot.image = std::move(image);
+    slot.image->slot_ = index;
+    slot.name = name;
+    slot.lastUsedFrame = frame_index_;
+    slot.restoring = false;
+
+    ImageHandle handle{index, slot.generation};
+    image_names_[name] = handle;
+    return handle;
+}
+
+bool Graphics::unloadImage(const std::string& name) {
+    auto it = image_names_.find(name);
+    if (it == image_names_.end()) {
+        return false;
+    }
+    return unloadImage(it->second);
+}
+
+bool Graphics::unloadImage(ImageHandle handle) {
+    Image* image = getImage(handle);
+    if (!image) {
         return false;
     }
 
-    images_[name] = std::move(image);
+    // Queued quads may still reference the texture
+    flushBatch();
+    forgetTexture(image->getTexture());
+    forgetTexture(image->standalone_);
+
+    ImageSlot& slot = image_slots_[handle.index];
+    image_names_.erase(slot.name);
+    slot.image.reset();
+    slot.name.clear();
+    if (++slot.generation == 0) {
+        slot.generation = 1;
+    }
+    free_image_slots_.push_back(handle.index);
     return true;
 }
 
-bool Graphics::unloadImage(const std::string& name) {
-    auto it = images_.find(name);
-    if (it != images_.end()) {
-        images_.erase(it);
-        return true;
+std::shared_ptr<ImageLoad> Graphics::loadImageAsync(const std::string& name, const std::string& filename) {
+    auto load = std::make_shared<ImageLoad>();
+    load->name_ = name;
+    load->filename_ = filename;
+    if (!renderer_) {
+        load->state_ = ImageLoad::State::Failed;
+        return load;
     }
-    return false;
+
+    // Progress counts from the first request after the queue drained
+    if (pending_loads_.empty()) {
+        loads_total_ = 0;
+        loads_completed_ = 0;
+        loads_failed_ = 0;
+    }
+
+    image_decoder_.start();
+    const uint64_t id = next_load_id_++;
+    pending_loads_[id] = load;
+    image_decoder_.enqueue(id, filename);
+    ++loads_total_;
+    return load;
+}
+
+void Graphics::setImageUploadBudget(float milliseconds) {
+    upload_budget_ms_ = std::max(0.0f, milliseconds);
+}
+
+ImageLoadProgress Graphics::getImageLoadProgress() const {
+    ImageLoadProgress progress;
+    progress.total = loads_total_;
+    progress.completed = loads_completed_;
+    progress.failed = loads_failed_;
+    progress.fraction = loads_total_ > 0 ? static_cast<float>(loads_completed_) / loads_total_ : 1.0f;
+    return progress;
+}
+
+// Uploads decoded images and reloads of evicted ones until the budget is spent; at least one
+// per frame so loading always advances
+void Graphics::processImageLoads() {
+    if (pending_loads_.empty() && pending_restores_.empty()) return;
+
+    const Uint64 start = SDL_GetTicksNS();
+    const Uint64 budget = static_cast<Uint64>(upload_budget_ms_ * 1000000.0f);
+    ImageDecoder::Result result;
+    while (image_decoder_.poll(&result)) {
+        auto it = pending_loads_.find(result.id);
+        if (it != pending_loads_.end()) {
+            std::shared_ptr<ImageLoad> load = std::move(it->second);
+            pending_loads_.erase(it);
+
+            auto image = std::make_unique<Image>();
+            if (result.pixels && image->loadPixels(result.pixels, result.width, result.height, renderer_, &image_atlas_)) {
+                image->source_ = load->filename_;
+                load->image_ = addImage(load->name_, std::move(image));
+                load->state_ = ImageLoad::State::Ready;
+            } else {
+                load->state_ = ImageLoad::State::Failed;
+                ++loads_failed_;
+            }
+            ++loads_completed_;
+        }
+
+        // A reload whose image was unloaded or replaced meanwhile is dropped; a failed one is
+        // requeued the next time the image is drawn
+        auto restore = pending_restores_.find(result.id);
+        if (restore != pending_restores_.end()) {
+            const ImageHandle handle = restore->second;
+            pending_restores_.erase(restore);
+
+            if (Image* image = getImage(handle)) {
+                // Counted as used so the budget check at this present() does not evict it straight away
+                ImageSlot& slot = image_slots_[handle.index];
+                slot.restoring = false;
+                slot.lastUsedFrame = frame_index_;
+                if (result.pixels && image->restore(result.pixels, result.width, result.height, renderer_)) {
+                    ++texture_reloads_;
+                }
+            }
+        }
+        ImageDecoder::freePixels(result.pixels);
+
+        if (SDL_GetTicksNS() - start >= budget) {
+            break;
+        }
+    }
+}
+
+bool Graphics::useImage(const Image* image) {
+    if (!image) {
+        return false;
+    }
+
+    if (image->slot_ < image_slots_.size() && image_slots_[image->slot_].image.get() == image) {
+        ImageSlot& slot = image_slots_[image->slot_];
+        slot.lastUsedFrame = frame_index_;
+
+        // Decoding happens off the draw path; the image shows up once processImageLoads uploads it
+        if (slot.image->isEvicted() && !slot.restoring) {
+            image_decoder_.start();
+            const uint64_t id = next_load_id_++;
+            pending_restores_[id] = {image->slot_, slot.generation};
+            image_decoder_.enqueue(id, slot.image->getSource());
+            slot.restoring = true;
+        }
+    }
+    return image->isValid();
+}
+
+// Meshes address the whole image with their own texture coordinates, which an atlas page
+// cannot offer: trimmed borders are missing and neighbours sit past the edges. Atlased images
+// get a one-off copy of their region, transparent borders restored, on the GPU.
+SDL_Texture* Graphics::standaloneTexture(Image& image) {
+    if (!image.atlas_) {
+        return image.getTexture();
+    }
+    if (image.standalone_) {
+        return image.standalone_;
+    }
+
+    SDL_Texture* page = image.getTexture();
+    SDL_Texture* copy = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET,
+                                          image.getWidth(), image.getHeight());
+    if (!copy) {
+        return nullptr;
+    }
+
+    SDL_BlendMode page_blend = SDL_BLENDMODE_BLEND;
+    SDL_ScaleMode page_scale = SDL_SCALEMODE_LINEAR;
+    SDL_GetTextureBlendMode(page, &page_blend);
+    SDL_GetTextureScaleMode(page, &page_scale);
+    SDL_SetTextureBlendMode(copy, page_blend);
+    SDL_SetTextureScaleMode(copy, page_scale);
+
+    // Switched and restored directly, so the tracked target, color and page blend mode stay valid
+    SDL_Texture* previous = SDL_GetRenderTarget(renderer_);
+    Uint8 r, g, b, a;
+    SDL_GetRenderDrawColor(renderer_, &r, &g, &b, &a);
+
+    SDL_SetRenderTarget(renderer_, copy);
+    SDL_SetRenderDrawColor(renderer_, 0, 0, 0, 0);
+    SDL_RenderClear(renderer_);
+
+    float page_w = 0.0f, page_h = 0.0f;
+    SDL_GetTextureSize(page, &page_w, &page_h);
+    const SDL_FRect& uv = image.tex_coords_;
+    const SDL_FRect src = {uv.x * page_w, uv.y * page_h, (uv.w - uv.x) * page_w, (uv.h - uv.y) * page_h};
+    SDL_SetTextureBlendMode(page, SDL_BLENDMODE_NONE);
+    SDL_RenderTexture(renderer_, page, &src, &image.bounds_);
+    SDL_SetTextureBlendMode(page, page_blend);
+
+    SDL_SetRenderTarget(renderer_, previous);
+    SDL_SetRenderDrawColor(renderer_, r, g, b, a);
+
+    image.standalone_ = copy;
+    return copy;
+}
+
+size_t Graphics::residentTextureBytes() const {
+    size_t bytes = 0;
+    for (const auto& page : image_atlas_.getStats()) {
+        bytes += static_cast<size_t>(page.width) * page.height * 4;
+    }
+    for (const ImageSlot& slot : image_slots_) {
+        if (slot.image) {
+            bytes += slot.image->getTextureBytes();
+        }
+    }
+    return bytes;
+}
+
+// Evicts least recently drawn standalone textures until under budget. Anything drawn this
+// frame stays, so a budget smaller than one frame's working set only overshoots.
+void Graphics::enforceTextureBudget() {
+    if (texture_budget_ == 0) return;
+
+    size_t resident = residentTextureBytes();
+    if (resident <= texture_budget_) return;
+
+    std::vector<uint32_t> candidates;
+    for (uint32_t i = 0; i < image_slots_.size(); ++i) {
+        const ImageSlot& slot = image_slots_[i];
+        if (slot.image && slot.image->getTextureBytes() > 0 && slot.lastUsedFrame < frame_index_) {
+            candidates.push_back(i);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [this](uint32_t a, uint32_t b) {
+        return image_slots_[a].lastUsedFrame < image_slots_[b].lastUsedFrame;
+    });
+
+    for (uint32_t index : candidates) {
+        if (resident <= texture_budget_) break;
+
+        Image& image = *image_slots_[index].image;
+        const size_t bytes = image.getTextureBytes();
+        SDL_Texture* texture = image.getTexture();
+        if (image.evict()) {
+            forgetTexture(texture);
+            resident -= bytes;
+            ++texture_evictions_;
+        }
+    }
+}
+
+TextureStats Graphics::getTextureStats() const {
+    TextureStats stats;
+    stats.residentBytes = residentTextureBytes();
+    stats.budgetBytes = texture_budget_;
+    for (const ImageSlot& slot : image_slots_) {
+        if (!slot.image) continue;
+        if (slot.image->isEvicted()) {
+            ++stats.evictedImages;
+        } else if (slot.image->isValid()) {
+            ++stats.residentImages;
+        }
+    }
+    stats.evictions = texture_evictions_;
+    stats.reloads = texture_reloads_;
+    return stats;
+}
+
+void Graphics::cancelImageLoads() {
+    image_decoder_.stop();
+    for (auto& [id, load] : pending_loads_) {
+        load->state_ = ImageLoad::State::Failed;
+    }
+    pending_loads_.clear();
+
+    for (const auto& [id, handle] : pending_restores_) {
+        if (getImage(handle)) {
+            image_slots_[handle.index].restoring = false;
+        }
+    }
+    pending_restores_.clear();
 }
 
 Image* Graphics::getImage(const std::string& name) {
-    auto it = images_.find(name);
-    if (it != images_.end()) {
-        return it->second.get();
+    return getImage(findImage(name));
+}
+
+ImageHandle Graphics::findImage(const std::string& name) const {
+    auto it = image_names_.find(name);
+    if (it != image_names_.end()) {
+        return it->second;
+    }
+    return {};
+}
+
+// Handle-based draw methods
+void Graphics::draw(ImageHandle handle, float x, float y) {
+    Image* image = getImage(handle);
+    if (image) {
+        draw(*image, x, y);
+    }
+}
+
+void Graphics::draw(ImageHandle handle, float x, float y, float rotation, float sx, float sy, float ox, float oy) {
+    Image* image = getImage(handle);
+    if (image) {
+        draw(*image, x, y, rotation, sx, sy, ox, oy);
     }
-    return nullptr;
 }
 
 // String-based draw methods
@@ -539,7 +1492,12 @@ std::pair<int, int> Graphics::getTextSize(const std::string& text) {
         const int charWidth = SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE;
         const int charHeight = SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE;
 
-        int width = static_cast<int>(text.length()) * charWidth;
+        // One cell per codepoint, as SDL decodes UTF-8 for the debug font too
+        int count = 0;
+        for (size_t i = 0; i < text.length(); ++count) {
+            decodeUtf8(text, &i);
+        }
+        int width = count * charWidth;
         int height = charHeight;
 
         return {width, height};
@@ -586,8 +1544,182 @@ void Graphics::printAligned(const std::string& text, float x, float y, float wid
 }
 
 void Graphics::printf(const std::string& text, float x, float y, float limit, const std::string& align) {
-    // Formatted text rendering placeholder
-    (void)text; (void)x; (void)y; (void)limit; (void)align; // Suppress unused parameter warnings
+    if (!renderer_ || text.empty()) return;
+
+    syncView();
+
+    TextAlign text_align = TextAlign::Left;
+    if (align == "center") {
+        text_align = TextAlign::Center;
+    } else if (align == "right") {
+        text_align = TextAlign::Right;
+    } else if (align == "justify") {
+        text_align = TextAlign::Justify;
+    }
+
+    const TextLayout& layout = layoutText(text, std::max(limit, 0.0f), text_align);
+    if (isCulled(x, y, x + limit, y + layout.height)) return;
+
+    if (current_font_ && current_font_->isLoaded()) {
+        const SDL_FColor color = toFColor(current_color_);
+        for (const PlacedGlyph& placed : layout.glyphs) {
+            const Glyph* glyph = placed.glyph;
+            const float px = x + placed.x, py = y + placed.y;
+            const SDL_FPoint positions[4] = {
+                {px + glyph->x0, py + glyph->y0}, {px + glyph->x1, py + glyph->y0},
+                {px + glyph->x1, py + glyph->y1}, {px + glyph->x0, py + glyph->y1}
+            };
+            const SDL_FPoint texCoords[4] = {
+                {glyph->u0, glyph->v0}, {glyph->u1, glyph->v0},
+                {glyph->u1, glyph->v1}, {glyph->u0, glyph->v1}
+            };
+            batchQuad(glyph->texture, positions, texCoords, color);
+        }
+    } else {
+        for (const TextLine& line : layout.lines) {
+            if (line.end > line.start) {
+                print(text.substr(line.start, line.end - line.start), x + line.x, y + line.y);
+            }
+        }
+    }
+}
+
+// Advance of one character including kerning with the next, in the current font
+float Graphics::glyphAdvance(uint32_t codepoint, uint32_t next) {
+    if (!current_font_ || !current_font_->isLoaded()) {
+        return static_cast<float>(SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE);
+    }
+
+    const Glyph* glyph = current_font_->getGlyph(renderer_, codepoint);
+    float advance = glyph ? glyph->advance : 0.0f;
+    if (next) {
+        advance += current_font_->getKerning(codepoint, next);
+    }
+    return advance;
+}
+
+// Greedy word wrap: lines break at the last space that fits, or mid-word when a single
+// word is wider than the limit. Explicit newlines always break.
+const Graphics::TextLayout& Graphics::layoutText(const std::string& text, float limit, TextAlign align) {
+    const Font* font = (current_font_ && current_font_->isLoaded()) ? current_font_ : nullptr;
+    TextLayoutKey key{font, text, limit, align};
+    auto found = text_layouts_.find(key);
+    if (found != text_layouts_.end()) {
+        found->second.lastUsedFrame = frame_index_;
+        return found->second;
+    }
+
+    // Layouts not drawn this frame are dropped once the cache fills up
+    if (text_layouts_.size() >= MAX_TEXT_LAYOUTS) {
+        std::erase_if(text_layouts_, [this](const auto& entry) {
+            return entry.second.lastUsedFrame < frame_index_;
+        });
+    }
+
+    TextLayout layout;
+    layout.lastUsedFrame = frame_index_;
+    const float line_height = font ? font->getLineHeight() : static_cast<float>(SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE);
+    const size_t length = text.size();
+
+    // Codepoint starting at byte i, or 0 past the end
+    auto peek = [&](size_t i) -> uint32_t {
+        return i < length ? decodeUtf8(text, &i) : 0;
+    };
+
+    size_t line_start = 0;
+    while (line_start <= length) {
+        // Measure until the limit, remembering the last space as the preferred break
+        float width = 0.0f;
+        float content_width = 0.0f;   // Up to the last non-space character
+        size_t content_end = line_start;
+        size_t break_end = 0, break_next = 0;
+        float break_width = 0.0f;
+        size_t i = line_start;
+        size_t next_start = length + 1;
+
+        while (i < length) {
+            const size_t char_start = i;
+            const uint32_t c = decodeUtf8(text, &i);
+            if (c == '\n') {
+                next_start = i;
+                break;
+            }
+
+            const uint32_t following = peek(i);
+            const float advance = glyphAdvance(c, following == '\n' ? 0 : following);
+            if (c == ' ') {
+                break_end = content_end;
+                break_width = content_width;
+                break_next = i;
+                width += advance;
+                continue;
+            }
+
+            if (width + advance > limit && content_end > line_start) {
+                if (break_next > line_start) {
+                    content_end = break_end;
+                    content_width = break_width;
+                    next_start = break_next;
+                } else {
+                    next_start = char_start;
+                }
+                break;
+            }
+
+            width += advance;
+            content_end = i;
+            content_width = width;
+        }
+
+        // Spaces right after a soft break do not start the next line
+        if (next_start <= length && next_start > 0 && text[next_start - 1] != '\n') {
+            while (next_start < length && text[next_start] == ' ') {
+                ++next_start;
+            }
+        }
+
+        TextLine line;
+        line.start = line_start;
+        line.end = content_end;
+        line.width = content_width;
+        line.y = static_cast<float>(layout.lines.size()) * line_height;
+        line.spaces = 0;
+        for (size_t k = line.start; k < line.end; ++k) {
+            line.spaces += text[k] == ' ';
+        }
+
+        // Justified lines stretch their spaces, except the last line of a paragraph
+        const bool paragraph_end = next_start > length || text[next_start - 1] == '\n';
+        switch (align) {
+            case TextAlign::Center: line.x = std::floor((limit - line.width) * 0.5f); break;
+            case TextAlign::Right: line.x = limit - line.width; break;
+            default: line.x = 0.0f; break;
+        }
+        layout.lines.push_back(line);
+
+        if (font) {
+            const float space_extra = (align == TextAlign::Justify && !paragraph_end && line.spaces > 0)
+                                          ? (limit - line.width) / line.spaces : 0.0f;
+            float pen = line.x;
+            const float baseline = line.y + current_font_->getAscent();
+            for (size_t k = line.start; k < line.end;) {
+                const uint32_t codepoint = decodeUtf8(text, &k);
+                const Glyph* glyph = current_font_->getGlyph(renderer_, codepoint);
+                if (glyph && glyph->texture) {
+                    layout.glyphs.push_back({glyph, pen, baseline});
+                }
+                pen += glyphAdvance(codepoint, k < line.end ? peek(k) : 0);
+                if (codepoint == ' ') {
+                    pen += space_extra;
+                }
+            }
+        }
+
+        line_start = next_start;
+    }
+
+    layout.height = static_cast<float>(layout.lines.size()) * line_height;
+    return text_layouts_.emplace(std::move(key), std::move(layout)).first->second;
 }
 
 void Graphics::push() {
@@ -598,43 +1730,520 @@ void Graphics::pop() {
     if (!transform_stack_.empty()) {
         current_transform_ = transform_stack_.back();
         transform_stack_.pop_back();
+        transformChanged();
     }
 }
 
+// Each operation post-multiplies the current matrix, so it applies to
+// coordinates before the transforms that were already on the stack.
 void Graphics::translate(float x, float y) {
-    current_transform_.tx += x;
-    current_transform_.ty += y;
+    Transform& t = current_transform_;
+    t.tx += t.a * x + t.c * y;
+    t.ty += t.b * x + t.d * y;
+    transformChanged();
 }
 
 void Graphics::rotate(float angle) {
-    current_transform_.rotation += angle;
+    Transform& t = current_transform_;
+    const float cs = std::cos(angle);
+    const float sn = std::sin(angle);
+    const float a = t.a * cs + t.c * sn;
+    const float b = t.b * cs + t.d * sn;
+    const float c = t.c * cs - t.a * sn;
+    const float d = t.d * cs - t.b * sn;
+    t.a = a;
+    t.b = b;
+    t.c = c;
+    t.d = d;
+    transformChanged();
 }
 
 void Graphics::scale(float sx, float sy) {
-    current_transform_.sx *= sx;
-    current_transform_.sy *= sy;
+    Transform& t = current_transform_;
+    t.a *= sx;
+    t.b *= sx;
+    t.c *= sy;
+    t.d *= sy;
+    transformChanged();
 }
 
-void Graphics::applyTransform() {
-    // Transform application would be implemented here
+void Graphics::origin() {
+    current_transform_ = Transform();
+    transformChanged();
 }
 
-// Text alignment helper functions
-std::pair<HorizontalAlign, VerticalAlign> Graphics::parseAlignment(const std::string& align) {
-    HorizontalAlign halign = HorizontalAlign::Left;
-    VerticalAlign valign = VerticalAlign::Top;
+std::pair<float, float> Graphics::transformPoint(float x, float y) {
+    syncView();
+    const Transform& t = render_transform_;
+    return {t.a * x + t.c * y + t.tx, t.b * x + t.d * y + t.ty};
+}
 
-    if (align.find("center") != std::string::npos) {
-        halign = HorizontalAlign::Center;
-    } else if (align.find("right") != std::string::npos) {
-        halign = HorizontalAlign::Right;
+std::pair<float, float> Graphics::inverseTransformPoint(float x, float y) {
+    syncView();
+    const Transform& t = render_transform_;
+    const float det = t.a * t.d - t.b * t.c;
+    if (det == 0.0f) {
+        return {0.0f, 0.0f};
     }
 
-    if (align.find("middle") != std::string::npos) {
-        valign = VerticalAlign::Middle;
-    } else if (align.find("bottom") != std::string::npos) {
-        valign = VerticalAlign::Bottom;
-    }
+    const float dx = x - t.tx;
+    const float dy = y - t.ty;
+    return {(t.d * dx - t.c * dy) / det, (t.a * dy - t.b * dx) / det};
+}
+
+// Axis-aligned bounds of the current view in local (untransformed) coordinates
+bool Graphics::getVisibleBounds(float* x0, float* y0, float* x1, float* y1) {
+    syncView();
+    if (!renderer_ || view_width_ <= 0.0f || view_height_ <= 0.0f) {
+        return false;
+    }
+
+    const float width = view_width_;
+    const float height = view_height_;
+    const std::pair<float, float> corners[4] = {
+        inverseTransformPoint(0.0f, 0.0f),
+        inverseTransformPoint(width, 0.0f),
+        inverseTransformPoint(width, height),
+        inverseTransformPoint(0.0f, height)
+    };
+
+    *x0 = *x1 = corners[0].first;
+    *y0 = *y1 = corners[0].second;
+    for (const auto& corner : corners) {
+        *x0 = std::min(*x0, corner.first);
+        *y0 = std::min(*y0, corner.second);
+        *x1 = std::max(*x1, corner.first);
+        *y1 = std::max(*y1, corner.second);
+    }
+    return true;
+}
+
+void Graphics::transformVertices(SDL_Vertex* vertices, size_t count) const {
+    if (transform_is_identity_) {
+        return;
+    }
+
+    // Plain loop over locals so the compiler can keep the matrix in registers and vectorize
+    const float a = render_transform_.a, b = render_transform_.b;
+    const float c = render_transform_.c, d = render_transform_.d;
+    const float tx = render_transform_.tx, ty = render_transform_.ty;
+
+    for (size_t i = 0; i < count; ++i) {
+        const float x = vertices[i].position.x;
+        const float y = vertices[i].position.y;
+        vertices[i].position.x = a * x + c * y + tx;
+        vertices[i].position.y = b * x + d * y + ty;
+    }
+}
+
+void Graphics::transformPoints(SDL_FPoint* points, size_t count) const {
+    if (transform_is_identity_) {
+        return;
+    }
+
+    const float a = render_transform_.a, b = render_transform_.b;
+    const float c = render_transform_.c, d = render_transform_.d;
+    const float tx = render_transform_.tx, ty = render_transform_.ty;
+
+    for (size_t i = 0; i < count; ++i) {
+        const float x = points[i].x;
+        const float y = points[i].y;
+        points[i].x = a * x + c * y + tx;
+        points[i].y = b * x + d * y + ty;
+    }
+}
+
+// Batching helpers
+int Graphics::reserveBatch(SDL_Texture* texture, size_t vertexCount, size_t indexCount) {
+    // Blend modes come from the tracked state rather than an SDL query per primitive
+    SDL_BlendMode blend_mode = render_state_.blend_mode;
+    if (texture) {
+        if (texture != render_state_.blend_texture) {
+            render_state_.blend_texture = texture;
+            render_state_.texture_blend_mode = SDL_BLENDMODE_NONE;
+            SDL_GetTextureBlendMode(texture, &render_state_.texture_blend_mode);
+        }
+        blend_mode = render_state_.texture_blend_mode;
+    }
+
+    if (deferred_) {
+        // Deferred geometry accumulates until the queue is sorted, each run tagged with its key.
+        // A full batch submits what is queued so far, like a canvas change does.
+        if (!batch_vertices_.empty() && batch_vertices_.size() + vertexCount > MAX_BATCH_VERTICES) {
+            flushBatch();
+        }
+        queueDeferred(texture, blend_mode);
+    } else if (!batch_vertices_.empty() &&
+               (texture != batch_texture_ || blend_mode != batch_blend_mode_ ||
+                batch_vertices_.size() + vertexCount > MAX_BATCH_VERTICES)) {
+        // A change of texture or blend mode ends the current run
+        flushBatch();
+    }
+
+    batch_texture_ = texture;
+    batch_blend_mode_ = blend_mode;
+    batch_vertices_.reserve(batch_vertices_.size() + vertexCount);
+    batch_indices_.reserve(batch_indices_.size() + indexCount);
+
+    return static_cast<int>(batch_vertices_.size());
+}
+
+void Graphics::flushBatch() {
+    if (batch_vertices_.empty()) {
+        return;
+    }
+
+    if (renderer_ && !batch_indices_.empty()) {
+        if (!deferred_items_.empty()) {
+            submitDeferred();
+        } else {
+            SDL_RenderGeometry(renderer_, batch_texture_,
+                              batch_vertices_.data(), static_cast<int>(batch_vertices_.size()),
+                              batch_indices_.data(), static_cast<int>(batch_indices_.size()));
+        }
+    }
+
+    discardBatch();
+}
+
+void Graphics::discardBatch() {
+    // clear() keeps the capacity, so the buffers stop allocating after the first frames
+    batch_vertices_.clear();
+    batch_indices_.clear();
+    batch_texture_ = nullptr;
+    deferred_items_.clear();
+    deferred_texture_ids_.clear();
+}
+
+void Graphics::batchFan(float cx, float cy, float rx, float ry, float angle1, float angleRange, int segments) {
+    segments = std::max(segments, 1);
+    const SDL_FPoint* rim = buildArcPoints(cx, cy, rx, ry, angle1, angleRange, segments);
+
+    int base = reserveBatch(nullptr, segments + 2, segments * 3);
+
+    SDL_FColor color = toFColor(current_color_);
+
+    // Center vertex followed by the rim
+    batch_vertices_.push_back({{cx, cy}, color, {0.0f, 0.0f}});
+    for (int i = 0; i <= segments; ++i) {
+        batch_vertices_.push_back({rim[i], color, {0.0f, 0.0f}});
+    }
+
+    transformVertices(&batch_vertices_[base], segments + 2);
+
+    for (int i = 1; i < segments + 1; ++i) {
+        batch_indices_.push_back(base);          // center
+        batch_indices_.push_back(base + i);      // current vertex
+        batch_indices_.push_back(base + i + 1);  // next vertex
+    }
+}
+
+void Graphics::batchQuad(SDL_Texture* texture, const SDL_FPoint positions[4], const SDL_FPoint texCoords[4],
+                         const SDL_FColor& color) {
+    int base = reserveBatch(texture, 4, 6);
+
+    for (int i = 0; i < 4; ++i) {
+        batch_vertices_.push_back({positions[i], color, texCoords[i]});
+    }
+    transformVertices(&batch_vertices_[base], 4);
+
+    batch_indices_.push_back(base);
+    batch_indices_.push_back(base + 1);
+    batch_indices_.push_back(base + 2);
+    batch_indices_.push_back(base);
+    batch_indices_.push_back(base + 2);
+    batch_indices_.push_back(base + 3);
+}
+
+void Graphics::submitGeometry(SDL_Texture* texture, const SDL_Vertex* vertices, size_t vertexCount,
+                              const int* indices, size_t indexCount) {
+    if (vertexCount == 0 || indexCount == 0) {
+        return;
+    }
+
+    // Retained geometry is already in final coordinates, hand it to SDL as is
+    if (transform_is_identity_ && !deferred_) {
+        flushBatch();
+        SDL_RenderGeometry(renderer_, texture, vertices, static_cast<int>(vertexCount),
+                          indices, static_cast<int>(indexCount));
+        return;
+    }
+
+    // Otherwise copy it into the batch so the transform can be applied
+    int base = reserveBatch(texture, vertexCount, indexCount);
+    batch_vertices_.insert(batch_vertices_.end(), vertices, vertices + vertexCount);
+    transformVertices(&batch_vertices_[base], vertexCount);
+    for (size_t i = 0; i < indexCount; ++i) {
+        batch_indices_.push_back(base + indices[i]);
+    }
+}
+
+void Graphics::drawArcOutline(float cx, float cy, float rx, float ry, float angle1, float angleRange, int segments) {
+    segments = std::max(segments, 1);
+    SDL_FPoint* points = buildArcPoints(cx, cy, rx, ry, angle1, angleRange, segments);
+    transformPoints(points, segments + 1);
+    drawLineStrip(points, segments + 1);
+}
+
+// Line and point primitives take SDL's line renderer, except in deferred mode where
+// they become one-pixel quads so they can be sorted with everything else
+void Graphics::drawLineStrip(const SDL_FPoint* points, size_t count) {
+    if (count < 2) return;
+
+    if (line_width_ != 1.0f) {
+        strokeLineStrip(points, count);
+        return;
+    }
+
+    if (!deferred_) {
+        flushBatch();
+        applyDrawColor(current_color_);
+        SDL_RenderLines(renderer_, points, static_cast<int>(count));
+        return;
+    }
+
+    const size_t segments = count - 1;
+    int base = reserveBatch(nullptr, segments * 4, segments * 6);
+    const SDL_FColor color = toFColor(current_color_);
+
+    for (size_t i = 0; i < segments; ++i) {
+        // Pixel centers sit at +0.5, and the ends are extended so joints and end pixels are covered
+        const float x0 = points[i].x + 0.5f, y0 = points[i].y + 0.5f;
+        const float x1 = points[i + 1].x + 0.5f, y1 = points[i + 1].y + 0.5f;
+        float dx = x1 - x0, dy = y1 - y0;
+        const float length = std::sqrt(dx * dx + dy * dy);
+        if (length > 0.0f) {
+            dx = dx / length * 0.5f;
+            dy = dy / length * 0.5f;
+        } else {
+            dx = 0.5f;
+            dy = 0.0f;
+        }
+
+        const int v = base + static_cast<int>(i * 4);
+        batch_vertices_.push_back({{x0 - dx + dy, y0 - dy - dx}, color, {0.0f, 0.0f}});
+        batch_vertices_.push_back({{x1 + dx + dy, y1 + dy - dx}, color, {0.0f, 0.0f}});
+        batch_vertices_.push_back({{x1 + dx - dy, y1 + dy + dx}, color, {0.0f, 0.0f}});
+        batch_vertices_.push_back({{x0 - dx - dy, y0 - dy + dx}, color, {0.0f, 0.0f}});
+
+        batch_indices_.push_back(v);
+        batch_indices_.push_back(v + 1);
+        batch_indices_.push_back(v + 2);
+        batch_indices_.push_back(v);
+        batch_indices_.push_back(v + 2);
+        batch_indices_.push_back(v + 3);
+    }
+}
+
+// Tessellates a transformed line strip of line width into the batch. A strip that ends where
+// it starts is closed and joined all the way round; ends are left square (butt caps).
+void Graphics::strokeLineStrip(const SDL_FPoint* points, size_t count) {
+    // Repeated points have no direction
+    stroke_points_.clear();
+    for (size_t i = 0; i < count; ++i) {
+        if (stroke_points_.empty() || stroke_points_.back().x != points[i].x ||
+            stroke_points_.back().y != points[i].y) {
+            stroke_points_.push_back(points[i]);
+        }
+    }
+    const bool closed = stroke_points_.size() > 2 && stroke_points_.front().x == stroke_points_.back().x &&
+                        stroke_points_.front().y == stroke_points_.back().y;
+    if (closed) {
+        stroke_points_.pop_back();
+    }
+
+    const size_t n = stroke_points_.size();
+    if (n < 2) return;
+
+    // Points are already transformed, so scale the width by the transform's area scale
+    const Transform& t = render_transform_;
+    const float half = 0.5f * line_width_ * std::sqrt(std::fabs(t.a * t.d - t.b * t.c));
+    const size_t segments = closed ? n : n - 1;
+    const SDL_FPoint* p = stroke_points_.data();
+    const SDL_FColor color = toFColor(current_color_);
+
+    auto normal = [&](size_t segment) -> SDL_FPoint {
+        const SDL_FPoint& a = p[segment];
+        const SDL_FPoint& b = p[(segment + 1) % n];
+        const float dx = b.x - a.x, dy = b.y - a.y;
+        const float length = std::sqrt(dx * dx + dy * dy);
+        return {-dy / length, dx / length};
+    };
+
+    // Separate quads per segment. Joins fill the outer notch: a bevel with one triangle, a
+    // miter with two up to its tip, falling back to a bevel past MITER_LIMIT or on a U-turn.
+    const size_t joints = (line_join_ != LineJoin::None) ? (closed ? n : n - 2) : 0;
+    int base = reserveBatch(nullptr, segments * 4 + joints * 2, segments * 6 + joints * 6);
+    for (size_t s = 0; s < segments; ++s) {
+        const SDL_FPoint nrm = normal(s);
+        const SDL_FPoint& a = p[s];
+        const SDL_FPoint& b = p[(s + 1) % n];
+        const float ox = nrm.x * half, oy = nrm.y * half;
+
+        batch_vertices_.push_back({{a.x + ox, a.y + oy}, color, {0.0f, 0.0f}});
+        batch_vertices_.push_back({{a.x - ox, a.y - oy}, color, {0.0f, 0.0f}});
+        batch_vertices_.push_back({{b.x - ox, b.y - oy}, color, {0.0f, 0.0f}});
+        batch_vertices_.push_back({{b.x + ox, b.y + oy}, color, {0.0f, 0.0f}});
+
+        const int v = base + static_cast<int>(s * 4);
+        batch_indices_.insert(batch_indices_.end(), {v, v + 1, v + 2, v, v + 2, v + 3});
+    }
+
+    for (size_t j = 0; j < joints; ++j) {
+        const size_t i = closed ? j : j + 1; // Point the joint sits on
+        const size_t in = (i + n - 1) % n;   // Incoming and outgoing segments
+        const size_t out = i;
+        const SDL_FPoint n0 = normal(in);
+        const SDL_FPoint n1 = normal(out);
+
+        // The outer side is the one the path turns away from
+        const bool turns_toward_normal = n0.x * n1.y - n0.y * n1.x > 0.0f;
+        const int in_end = base + static_cast<int>(in * 4) + (turns_toward_normal ? 2 : 3);
+        const int out_start = base + static_cast<int>(out * 4) + (turns_toward_normal ? 1 : 0);
+
+        const int center = static_cast<int>(batch_vertices_.size());
+        batch_vertices_.push_back({p[i], color, {0.0f, 0.0f}});
+
+        if (line_join_ == LineJoin::Miter) {
+            // The miter tip lies on the bisector, half / cos(half the turn) out on the outer side
+            float mx = n0.x + n1.x, my = n0.y + n1.y;
+            const float length = std::sqrt(mx * mx + my * my);
+            const float cosine = length * 0.5f;
+            if (cosine * MITER_LIMIT >= 1.0f) {
+                const float offset = (turns_toward_normal ? -half : half) / (cosine * length);
+                const int tip = static_cast<int>(batch_vertices_.size());
+                batch_vertices_.push_back({{p[i].x + mx * offset, p[i].y + my * offset}, color, {0.0f, 0.0f}});
+                batch_indices_.insert(batch_indices_.end(), {center, in_end, tip, center, tip, out_start});
+                continue;
+            }
+        }
+        batch_indices_.insert(batch_indices_.end(), {center, in_end, out_start});
+    }
+}
+
+float Graphics::strokeExtent(DrawMode mode) const {
+    if (mode != DrawMode::Line) {
+        return 0.0f;
+    }
+    const float half = 0.5f * line_width_;
+    return line_join_ == LineJoin::Miter ? half * MITER_LIMIT : half;
+}
+
+void Graphics::drawPoints(const SDL_FPoint* points, size_t count) {
+    if (count == 0) return;
+
+    if (!deferred_) {
+        flushBatch();
+        applyDrawColor(current_color_);
+        SDL_RenderPoints(renderer_, points, static_cast<int>(count));
+        return;
+    }
+
+    int base = reserveBatch(nullptr, count * 4, count * 6);
+    const SDL_FColor color = toFColor(current_color_);
+
+    for (size_t i = 0; i < count; ++i) {
+        const float x = points[i].x, y = points[i].y;
+        const int v = base + static_cast<int>(i * 4);
+        batch_vertices_.push_back({{x, y}, color, {0.0f, 0.0f}});
+        batch_vertices_.push_back({{x + 1.0f, y}, color, {0.0f, 0.0f}});
+        batch_vertices_.push_back({{x + 1.0f, y + 1.0f}, color, {0.0f, 0.0f}});
+        batch_vertices_.push_back({{x, y + 1.0f}, color, {0.0f, 0.0f}});
+
+        batch_indices_.push_back(v);
+        batch_indices_.push_back(v + 1);
+        batch_indices_.push_back(v + 2);
+        batch_indices_.push_back(v);
+        batch_indices_.push_back(v + 2);
+        batch_indices_.push_back(v + 3);
+    }
+}
+
+// Returns segments + 1 rim points in the reusable scratch buffer
+SDL_FPoint* Graphics::buildArcPoints(float cx, float cy, float rx, float ry, float angle1, float angleRange,
+                                     int segments) {
+    scratch_points_.resize(segments + 1);
+    SDL_FPoint* out = scratch_points_.data();
+
+    // Whole ellipses come straight from the cached unit circle; tables are only kept for the
+    // counts automatic segmentation can pick, larger explicit counts are stepped below
+    if (angle1 == 0.0f && std::fabs(angleRange) == static_cast<float>(2.0 * M_PI) &&
+        segments <= MAX_CIRCLE_SEGMENTS) {
+        const std::vector<SDL_FPoint>& unit = unitCircle(segments);
+        const float sign = angleRange < 0.0f ? -1.0f : 1.0f;
+        for (int i = 0; i <= segments; ++i) {
+            out[i] = {cx + rx * unit[i].x, cy + ry * sign * unit[i].y};
+        }
+        return out;
+    }
+
+    // Partial arcs rotate a unit vector by a fixed step: two sin/cos pairs per arc, not per segment
+    const float step = angleRange / segments;
+    const float stepCos = std::cos(step);
+    const float stepSin = std::sin(step);
+    float ux = std::cos(angle1);
+    float uy = std::sin(angle1);
+    for (int i = 0; i <= segments; ++i) {
+        out[i] = {cx + rx * ux, cy + ry * uy};
+        const float nx = ux * stepCos - uy * stepSin;
+        uy = ux * stepSin + uy * stepCos;
+        ux = nx;
+    }
+    return out;
+}
+
+const std::vector<SDL_FPoint>& Graphics::unitCircle(int segments) {
+    if (unit_circles_.size() <= static_cast<size_t>(segments)) {
+        unit_circles_.resize(segments + 1);
+    }
+
+    std::vector<SDL_FPoint>& table = unit_circles_[segments];
+    if (table.empty()) {
+        table.resize(segments + 1);
+        for (int i = 0; i < segments; ++i) {
+            double angle = (double(i) / segments) * 2.0 * M_PI;
+            table[i] = {static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle))};
+        }
+        table[segments] = table[0]; // Closed loop without a seam
+    }
+    return table;
+}
+
+// Picks a segment count that keeps the chord error around half a pixel at the on-screen radius
+int Graphics::autoSegments(float radius) const {
+    const Transform& t = render_transform_;
+    const float scale = std::sqrt(std::max(t.a * t.a + t.b * t.b, t.c * t.c + t.d * t.d));
+    const float screenRadius = radius * scale;
+
+    if (screenRadius <= 1.0f) {
+        return MIN_CIRCLE_SEGMENTS;
+    }
+
+    const float maxError = 0.5f;
+    const float step = 2.0f * std::acos(std::max(-1.0f, 1.0f - maxError / screenRadius));
+    int segments = static_cast<int>(std::ceil(2.0f * M_PI / step));
+
+    // Round up to a multiple of 4 so nearby radii share cached tables
+    segments = (segments + 3) & ~3;
+    return std::clamp(segments, MIN_CIRCLE_SEGMENTS, MAX_CIRCLE_SEGMENTS);
+}
+
+// Text alignment helper functions
+std::pair<HorizontalAlign, VerticalAlign> Graphics::parseAlignment(const std::string& align) {
+    HorizontalAlign halign = HorizontalAlign::Left;
+    VerticalAlign valign = VerticalAlign::Top;
+
+    if (align.find("center") != std::string::npos) {
+        halign = HorizontalAlign::Center;
+    } else if (align.find("right") != std::string::npos) {
+        halign = HorizontalAlign::Right;
+    }
+
+    if (align.find("middle") != std::string::npos) {
+        valign = VerticalAlign::Middle;
+    } else if (align.find("bottom") != std::string::npos) {
+        valign = VerticalAlign::Bottom;
+    }
 
     return {halign, valign};
 }
@@ -706,4 +2315,556 @@ std::pair<float, float> Graphics::calculateAlignedPosition(const std::string& te
 }
 
 
+// Camera and culling
+void Graphics::setCamera(const Camera* camera) {
+    camera_ = camera;
+    view_dirty_ = true;
+}
+
+// Rebuilds the view transform when the camera or the render target has changed
+void Graphics::syncView() {
+    const uint32_t revision = camera_ ? camera_->getRevision() : 0;
+    if (!view_dirty_ && revision == camera_revision_) {
+        return;
+    }
+    view_dirty_ = false;
+    camera_revision_ = revision;
+
+    // The scene canvas is addressed in logical units and scaled down to its pixel size
+    int width = 0, height = 0;
+    float base_scale = 1.0f;
+    if (drawingToScene()) {
+        width = sceneWidth();
+        height = sceneHeight();
+        base_scale = render_scale_;
+    } else if (renderer_) {
+        SDL_GetCurrentRenderOutputSize(renderer_, &width, &height);
+    }
+
+    view_transform_ = Transform();
+    if (camera_ && camera_->hasViewport()) {
+        const SDL_Rect viewport = camera_->getViewport();
+        if (renderer_) {
+            const SDL_Rect scaled = scaleRect(viewport, base_scale);
+            applyViewport(&scaled);
+        }
+        width = viewport.w;
+        height = viewport.h;
+    } else if (renderer_) {
+        applyViewport(nullptr);
+    }
+    // Culling compares against render_transform_ output, which base_scale shrinks along with the canvas
+    view_width_ = width * base_scale;
+    view_height_ = height * base_scale;
+
+    if (camera_) {
+        // screen = centre + rotate(-rotation) * zoom * (world - position)
+        const auto [x, y] = camera_->getPosition();
+        const float zoom = camera_->getZoom();
+        const float cs = std::cos(-camera_->getRotation());
+        const float sn = std::sin(-camera_->getRotation());
+
+        Transform& v = view_transform_;
+        v.a = zoom * cs;
+        v.b = zoom * sn;
+        v.c = -zoom * sn;
+        v.d = zoom * cs;
+        v.tx = width * 0.5f - (v.a * x + v.c * y);
+        v.ty = height * 0.5f - (v.b * x + v.d * y);
+    }
+
+    if (base_scale != 1.0f) {
+        Transform& v = view_transform_;
+        v.a *= base_scale;
+        v.b *= base_scale;
+        v.c *= base_scale;
+        v.d *= base_scale;
+        v.tx *= base_scale;
+        v.ty *= base_scale;
+    }
+
+    transformChanged();
+}
+
+void Graphics::transformChanged() {
+    // The camera sits beneath the push/pop stack: render = view * current
+    const Transform& v = view_transform_;
+    const Transform& t = current_transform_;
+    Transform& r = render_transform_;
+    r.a = v.a * t.a + v.c * t.b;
+    r.b = v.b * t.a + v.d * t.b;
+    r.c = v.a * t.c + v.c * t.d;
+    r.d = v.b * t.c + v.d * t.d;
+    r.tx = v.a * t.tx + v.c * t.ty + v.tx;
+    r.ty = v.b * t.tx + v.d * t.ty + v.ty;
+    transform_is_identity_ = r.isIdentity();
+}
+
+// True when a local-space box lands entirely outside the view, so nothing needs to be built for it
+bool Graphics::isCulled(float x0, float y0, float x1, float y1) const {
+    const SDL_FPoint corners[4] = {{x0, y0}, {x1, y0}, {x1, y1}, {x0, y1}};
+    return isCulled(corners, 4);
+}
+
+bool Graphics::isCulled(const SDL_FPoint* points, size_t count) const {
+    if (view_width_ <= 0.0f || view_height_ <= 0.0f) {
+        return false;
+    }
+
+    const Transform& t = render_transform_;
+    float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+    for (size_t i = 0; i < count; ++i) {
+        const float x = t.a * points[i].x + t.c * points[i].y + t.tx;
+        const float y = t.b * points[i].x + t.d * points[i].y + t.ty;
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+        maxX = std::max(maxX, x);
+        maxY = std::max(maxY, y);
+    }
+
+    // One pixel of slack covers line and point rasterisation past the nominal bounds
+    if (maxX < -1.0f || maxY < -1.0f || minX > view_width_ + 1.0f || minY > view_height_ + 1.0f) {
+        ++cull_stats_.culled;
+        return true;
+    }
+    return false;
+}
+
+// Logical resolution and dynamic resolution scaling
+void Graphics::setLogicalSize(int width, int height, bool integerScale) {
+    logical_width_ = std::max(0, width);
+    logical_height_ = std::max(0, height);
+
+    // An existing scene canvas is only recreated on a size change, so the filter follows here
+    if (integerScale != logical_integer_scale_ && scene_canvas_.isValid()) {
+        SDL_SetTextureScaleMode(scene_canvas_.getTexture(),
+                                integerScale ? SDL_SCALEMODE_NEAREST : SDL_SCALEMODE_LINEAR);
+    }
+    logical_integer_scale_ = integerScale;
+}
+
+void Graphics::setRenderScale(float scale) {
+    render_scale_ = std::clamp(scale, MIN_RENDER_SCALE, 1.0f);
+}
+
+void Graphics::setDynamicResolution(bool enabled, float frameBudgetMs, float minScale) {
+    dynamic_resolution_ = enabled;
+    frame_budget_ms_ = std::max(1.0f, frameBudgetMs);
+    min_render_scale_ = std::clamp(minScale, MIN_RENDER_SCALE, 1.0f);
+    frame_time_avg_ms_ = 0.0f;
+    last_present_ns_ = 0;
+    frames_since_scale_change_ = 0;
+    raise_cooldown_frames_ = RAISE_COOLDOWN_FRAMES;
+    if (!enabled) {
+        render_scale_ = 1.0f;
+    }
+}
+
+std::pair<float, float> Graphics::toLogical(float x, float y) const {
+    if (!sceneActive()) {
+        return {x, y};
+    }
+
+    SDL_FRect dst;
+    if (!sceneDestRect(&dst) || dst.w <= 0.0f || dst.h <= 0.0f) {
+        return {x, y};
+    }
+    return {(x - dst.x) * sceneWidth() / dst.w, (y - dst.y) * sceneHeight() / dst.h};
+}
+
+int Graphics::sceneWidth() const {
+    if (logical_width_ > 0 && logical_height_ > 0) {
+        return logical_width_;
+    }
+    int width = 0;
+    if (renderer_) {
+        SDL_GetRenderOutputSize(renderer_, &width, nullptr);
+    }
+    return width;
+}
+
+int Graphics::sceneHeight() const {
+    if (logical_width_ > 0 && logical_height_ > 0) {
+        return logical_height_;
+    }
+    int height = 0;
+    if (renderer_) {
+        SDL_GetRenderOutputSize(renderer_, nullptr, &height);
+    }
+    return height;
+}
+
+bool Graphics::drawingToScene() const {
+    return scene_canvas_.isValid() && render_state_.target_valid &&
+           render_state_.target == scene_canvas_.getTexture();
+}
+
+SDL_Texture* Graphics::screenTarget() const {
+    return (sceneActive() && scene_canvas_.isValid()) ? scene_canvas_.getTexture() : nullptr;
+}
+
+SDL_Rect Graphics::scaleRect(const SDL_Rect& rect, float scale) {
+    if (scale == 1.0f) {
+        return rect;
+    }
+    const int x0 = static_cast<int>(std::floor(rect.x * scale));
+    const int y0 = static_cast<int>(std::floor(rect.y * scale));
+    const int x1 = static_cast<int>(std::ceil((rect.x + rect.w) * scale));
+    const int y1 = static_cast<int>(std::ceil((rect.y + rect.h) * scale));
+    return {x0, y0, x1 - x0, y1 - y0};
+}
+
+// Keeps the scene canvas at logical size times the render scale, or drops it when unused
+void Graphics::ensureSceneCanvas() {
+    const int width = sceneActive() ? static_cast<int>(std::ceil(sceneWidth() * render_scale_)) : 0;
+    const int height = sceneActive() ? static_cast<int>(std::ceil(sceneHeight() * render_scale_)) : 0;
+    if (scene_canvas_.isValid() && scene_canvas_.getWidth() == width && scene_canvas_.getHeight() == height) {
+        return;
+    }
+
+    if (scene_canvas_.isValid()) {
+        if (drawingToScene()) {
+            applyRenderTarget(nullptr);
+        }
+        forgetTexture(scene_canvas_.getTexture());
+        scene_canvas_.release();
+    }
+
+    if (width <= 0 || height <= 0 || !scene_canvas_.create(renderer_, width, height)) {
+        return;
+    }
+
+    // The scene replaces the screen outright, and pixel-art scaling wants hard edges
+    SDL_SetTextureBlendMode(scene_canvas_.getTexture(), SDL_BLENDMODE_NONE);
+    SDL_SetTextureScaleMode(scene_canvas_.getTexture(),
+                            logical_integer_scale_ ? SDL_SCALEMODE_NEAREST : SDL_SCALEMODE_LINEAR);
+    view_dirty_ = true;
+}
+
+// Where the scene lands in the window: aspect-preserving, centred, optionally whole multiples only
+bool Graphics::sceneDestRect(SDL_FRect* dst) const {
+    int output_w = 0, output_h = 0;
+    if (!renderer_ || !SDL_GetRenderOutputSize(renderer_, &output_w, &output_h)) {
+        return false;
+    }
+
+    const float logical_w = static_cast<float>(sceneWidth());
+    const float logical_h = static_cast<float>(sceneHeight());
+    if (logical_w <= 0.0f || logical_h <= 0.0f) {
+        return false;
+    }
+
+    float scale = std::min(output_w / logical_w, output_h / logical_h);
+    if (logical_integer_scale_ && scale >= 1.0f) {
+        scale = std::floor(scale);
+    }
+
+    dst->w = logical_w * scale;
+    dst->h = logical_h * scale;
+    dst->x = std::floor((output_w - dst->w) * 0.5f);
+    dst->y = std::floor((output_h - dst->h) * 0.5f);
+    return true;
+}
+
+void Graphics::presentScene() {
+    applyRenderTarget(nullptr);
+    applyViewport(nullptr);
+    applyClipRect(nullptr);
+
+    // Letterbox bars
+    applyDrawColor(Color::black());
+    SDL_RenderClear(renderer_);
+
+    SDL_FRect dst;
+    if (sceneDestRect(&dst)) {
+        SDL_RenderTexture(renderer_, scene_canvas_.getTexture(), nullptr, &dst);
+    }
+}
+
+// Lowers the render scale when the smoothed frame time runs over budget. Raising it is probed
+// after a stable stretch, and the wait doubles whenever a raise is immediately undone.
+void Graphics::updateDynamicResolution() {
+    if (!dynamic_resolution_) return;
+
+    const Uint64 now = SDL_GetTicksNS();
+    if (last_present_ns_ == 0) {
+        last_present_ns_ = now;
+        return;
+    }
+
+    const float frame_ms = static_cast<float>(now - last_present_ns_) / 1000000.0f;
+    last_present_ns_ = now;
+    frame_time_avg_ms_ = (frame_time_avg_ms_ == 0.0f) ? frame_ms : frame_time_avg_ms_ * 0.9f + frame_ms * 0.1f;
+    ++frames_since_scale_change_;
+
+    if (frame_time_avg_ms_ > frame_budget_ms_ * 1.1f && render_scale_ > min_render_scale_ &&
+        frames_since_scale_change_ >= SCALE_SETTLE_FRAMES) {
+        if (last_change_was_raise_ && frames_since_scale_change_ < RAISE_COOLDOWN_FRAMES / 2) {
+            raise_cooldown_frames_ = std::min(raise_cooldown_frames_ * 2, MAX_RAISE_COOLDOWN_FRAMES);
+        } else {
+            raise_cooldown_frames_ = RAISE_COOLDOWN_FRAMES;
+        }
+        render_scale_ = std::max(min_render_scale_, render_scale_ - 0.1f);
+        last_change_was_raise_ = false;
+        frames_since_scale_change_ = 0;
+    } else if (frame_time_avg_ms_ <= frame_budget_ms_ * 1.02f && render_scale_ < 1.0f &&
+               frames_since_scale_change_ >= raise_cooldown_frames_) {
+        render_scale_ = std::min(1.0f, render_scale_ + 0.05f);
+        last_change_was_raise_ = true;
+        frames_since_scale_change_ = 0;
+    }
+}
+
+// Deferred draw queue
+void Graphics::setDeferred(bool deferred) {
+    if (deferred == deferred_) return;
+
+    // Whatever was queued under the old mode is submitted first
+    flushBatch();
+    deferred_ = deferred;
+}
+
+void Graphics::queueDeferred(SDL_Texture* texture, SDL_BlendMode blendMode) {
+    // Draws at the default layer and depth keep drawing order. Under any other key, textures get
+    // small ids in order of first use so equal keys group by texture; the id does not rank.
+    uint64_t textureId = 0;
+    if (draw_layer_ != 0 || draw_depth_ != 0.0f) {
+        textureId = 0xFFFF;
+        auto it = deferred_texture_ids_.find(texture);
+        if (it != deferred_texture_ids_.end()) {
+            textureId = it->second;
+        } else if (deferred_texture_ids_.size() < 0xFFFE) {
+            textureId = deferred_texture_ids_.size() + 1;
+            deferred_texture_ids_.emplace(texture, static_cast<uint16_t>(textureId));
+        }
+    }
+
+    // Key: layer (16 bits) | depth (32 bits, order-preserving float encoding) | texture (16 bits)
+    const int layer = std::clamp(draw_layer_, -32768, 32767) + 32768;
+    const float drawDepth = draw_depth_ == 0.0f ? 0.0f : draw_depth_; // -0 sorts with 0
+    uint32_t depth;
+    std::memcpy(&depth, &drawDepth, sizeof(depth));
+    depth = (depth & 0x80000000u) ? ~depth : (depth | 0x80000000u);
+    const uint64_t key = (uint64_t(layer) << 48) | (uint64_t(depth) << 16) | textureId;
+
+    // Consecutive primitives with the same key and state extend the previous run
+    if (!deferred_items_.empty()) {
+        const DeferredItem& last = deferred_items_.back();
+        if (last.key == key && last.texture == texture && last.blendMode == blendMode) {
+            return;
+        }
+    }
+
+    deferred_items_.push_back({key, static_cast<uint32_t>(batch_vertices_.size()), 0,
+                               static_cast<uint32_t>(batch_indices_.size()), 0, texture, blendMode});
+}
+
+void Graphics::sortDeferred() {
+    const size_t count = deferred_items_.size();
+    deferred_order_.resize(count);
+    deferred_sort_scratch_.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        deferred_order_[i] = {deferred_items_[i].key, static_cast<uint32_t>(i)};
+    }
+
+    // LSD radix sort, 8 bits per pass. It is stable, so equal keys keep submission order.
+    SortEntry* src = deferred_order_.data();
+    SortEntry* dst = deferred_sort_scratch_.data();
+    for (int shift = 0; shift < 64; shift += 8) {
+        size_t offsets[256] = {};
+        for (size_t i = 0; i < count; ++i) {
+            ++offsets[(src[i].key >> shift) & 0xFF];
+        }
+
+        // A pass where every key shares the same byte would not move anything
+        if (offsets[(src[0].key >> shift) & 0xFF] == count) {
+            continue;
+        }
+
+        size_t total = 0;
+        for (size_t& offset : offsets) {
+            const size_t n = offset;
+            offset = total;
+            total += n;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            dst[offsets[(src[i].key >> shift) & 0xFF]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+
+    if (src != deferred_order_.data()) {
+        std::copy(src, src + count, deferred_order_.data());
+    }
+}
+
+void Graphics::submitDeferred() {
+    const size_t count = deferred_items_.size();
+    for (size_t i = 0; i < count; ++i) {
+        DeferredItem& item = deferred_items_[i];
+        const bool last = i + 1 == count;
+        item.vertexCount = (last ? static_cast<uint32_t>(batch_vertices_.size())
+                                 : deferred_items_[i + 1].vertexStart) - item.vertexStart;
+        item.indexCount = (last ? static_cast<uint32_t>(batch_indices_.size())
+                                : deferred_items_[i + 1].indexStart) - item.indexStart;
+    }
+
+    // Submissions the queue would have needed in the order it was drawn
+    int unsortedBatches = 0;
+    const DeferredItem* previous = nullptr;
+    for (const DeferredItem& item : deferred_items_) {
+        if (item.indexCount == 0) continue;
+        if (!previous || item.texture != previous->texture || item.blendMode != previous->blendMode) {
+            ++unsortedBatches;
+        }
+        previous = &item;
+    }
+
+    sortDeferred();
+
+    // Runs of sorted items sharing state become one SDL_RenderGeometry; each run's vertices are
+    // compacted so SDL only converts the geometry that run draws
+    int batches = 0;
+    SDL_Texture* runTexture = nullptr;
+    SDL_BlendMode runBlendMode = SDL_BLENDMODE_NONE;
+    deferred_vertices_.clear();
+    deferred_indices_.clear();
+
+    auto submitRun = [&]() {
+        if (deferred_indices_.empty()) return;
+        SDL_RenderGeometry(renderer_, runTexture,
+                          deferred_vertices_.data(), static_cast<int>(deferred_vertices_.size()),
+                          deferred_indices_.data(), static_cast<int>(deferred_indices_.size()));
+        deferred_vertices_.clear();
+        deferred_indices_.clear();
+        ++batches;
+    };
+
+    for (const SortEntry& entry : deferred_order_) {
+        const DeferredItem& item = deferred_items_[entry.item];
+        if (item.indexCount == 0) continue;
+
+        if (!deferred_indices_.empty() && (item.texture != runTexture || item.blendMode != runBlendMode)) {
+            submitRun();
+        }
+        runTexture = item.texture;
+        runBlendMode = item.blendMode;
+
+        const int offset = static_cast<int>(deferred_vertices_.size()) - static_cast<int>(item.vertexStart);
+        const SDL_Vertex* vertices = batch_vertices_.data() + item.vertexStart;
+        deferred_vertices_.insert(deferred_vertices_.end(), vertices, vertices + item.vertexCount);
+
+        const int* indices = batch_indices_.data() + item.indexStart;
+        for (uint32_t i = 0; i < item.indexCount; ++i) {
+            deferred_indices_.push_back(indices[i] + offset);
+        }
+    }
+    submitRun();
+
+    queue_stats_.items += static_cast<int>(count);
+    queue_stats_.batches += batches;
+    queue_stats_.batchesSaved += unsortedBatches - batches;
+}
+
+// Render state tracking
+void Graphics::applyDrawColor(const Color& color) {
+    const SDL_Color c = {
+        static_cast<Uint8>(color.r * 255),
+        static_cast<Uint8>(color.g * 255),
+        static_cast<Uint8>(color.b * 255),
+        static_cast<Uint8>(color.a * 255)
+    };
+
+    RenderState& state = render_state_;
+    if (state.draw_color_valid && state.draw_color.r == c.r && state.draw_color.g == c.g &&
+        state.draw_color.b == c.b && state.draw_color.a == c.a) {
+        ++state_stats_.skipped;
+        return;
+    }
+
+    SDL_SetRenderDrawColor(renderer_, c.r, c.g, c.b, c.a);
+    state.draw_color = c;
+    state.draw_color_valid = true;
+    ++state_stats_.issued;
+}
+
+void Graphics::applyClipRect(const SDL_Rect* rect) {
+    RenderState& state = render_state_;
+    if (state.clip_valid) {
+        const bool same = rect ? (state.clip_enabled && state.clip_rect.x == rect->x && state.clip_rect.y == rect->y &&
+                                  state.clip_rect.w == rect->w && state.clip_rect.h == rect->h)
+                               : !state.clip_enabled;
+        if (same) {
+            ++state_stats_.skipped;
+            return;
+        }
+    }
+
+    // Pending geometry was meant for the old clip rect
+    flushBatch();
+    SDL_SetRenderClipRect(renderer_, rect);
+    state.clip_enabled = rect != nullptr;
+    if (rect) {
+        state.clip_rect = *rect;
+    }
+    state.clip_valid = true;
+    ++state_stats_.issued;
+}
+
+void Graphics::applyRenderTarget(SDL_Texture* target) {
+    if (render_state_.target_valid && render_state_.target == target) {
+        ++state_stats_.skipped;
+        return;
+    }
+
+    SDL_SetRenderTarget(renderer_, target);
+    render_state_.target = target;
+    render_state_.target_valid = true;
+    ++state_stats_.issued;
+
+    // SDL keeps a viewport and clip rect per target, so both are re-applied after a switch
+    render_state_.viewport_valid = false;
+    render_state_.clip_valid = false;
+    applyScissor();
+    view_dirty_ = true;
+}
+
+void Graphics::applyViewport(const SDL_Rect* rect) {
+    RenderState& state = render_state_;
+    if (state.viewport_valid) {
+        const bool same = rect ? (state.viewport_enabled && state.viewport.x == rect->x &&
+                                  state.viewport.y == rect->y && state.viewport.w == rect->w &&
+                                  state.viewport.h == rect->h)
+                               : !state.viewport_enabled;
+        if (same) {
+            ++state_stats_.skipped;
+            return;
+        }
+    }
+
+    flushBatch();
+    SDL_SetRenderViewport(renderer_, rect);
+    state.viewport_enabled = rect != nullptr;
+    if (rect) {
+        state.viewport = *rect;
+    }
+    state.viewport_valid = true;
+    ++state_stats_.issued;
+}
+
+void Graphics::forgetTexture(SDL_Texture* texture) {
+    // The pointer may be reused by a new texture once this one is destroyed
+    if (render_state_.blend_texture == texture) {
+        render_state_.blend_texture = nullptr;
+    }
+}
+
+void Graphics::invalidateRenderState() {
+    // Nothing is assumed about the renderer until each piece of state has been set once
+    render_state_ = {};
+    if (renderer_) {
+        SDL_GetRenderDrawBlendMode(renderer_, &render_state_.blend_mode);
+    }
+}
+
 } // namespace tsuki
\ No newline at end of file
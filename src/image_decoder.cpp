@@ -0,0 +1,100 @@
+#include "tsuki/image_decoder.hpp"
+#include <algorithm>
+
+#include "stb_image.h"
+
+namespace tsuki {
+
+ImageDecoder::~ImageDecoder() {
+    stop();
+}
+
+void ImageDecoder::start(int threadCount) {
+    if (!workers_.empty()) {
+        return;
+    }
+
+    // Leave a core for the main thread
+    if (threadCount <= 0) {
+        const int hardware = static_cast<int>(std::thread::hardware_concurrency());
+        threadCount = std::clamp(hardware - 1, 1, 4);
+    }
+
+    stopping_ = false;
+    workers_.reserve(threadCount);
+    for (int i = 0; i < threadCount; ++i) {
+        workers_.emplace_back(&ImageDecoder::workerLoop, this);
+    }
+}
+
+void ImageDecoder::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        jobs_.clear();
+    }
+    wake_.notify_all();
+
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+
+    for (Result& result : results_) {
+        freePixels(result.pixels);
+    }
+    results_.clear();
+}
+
+void ImageDecoder::enqueue(uint64_t id, const std::string& filename) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back({id, filename});
+    }
+    wake_.notify_one();
+}
+
+bool ImageDecoder::poll(Result* result) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (results_.empty()) {
+        return false;
+    }
+    *result = results_.front();
+    results_.pop_front();
+    return true;
+}
+
+void ImageDecoder::freePixels(unsigned char* pixels) {
+    if (pixels) {
+        stbi_image_free(pixels);
+    }
+}
+
+void ImageDecoder::workerLoop() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+            if (stopping_) {
+                return;
+            }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+
+        Result result;
+        result.id = job.id;
+        int channels = 0;
+        result.pixels = stbi_load(job.filename.c_str(), &result.width, &result.height, &channels, 4);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            freePixels(result.pixels);
+            return;
+        }
+        results_.push_back(result);
+    }
+}
+
+} // namespace tsuki
@@ -1,9 +1,126 @@
 #include "tsuki/lua_bindings.hpp"
 #include "tsuki/tsuki.hpp"
 #include <spdlog/spdlog.h>
+#include <algorithm>
+#include <climits>
 
 namespace tsuki {
 
+namespace {
+
+// Builds a sprite from the trailing (x, y, r, sx, sy, ox, oy) arguments shared by the SpriteBatch helpers
+SpriteBatch::Sprite makeSprite(const SpriteBatch& batch, float x, float y, sol::optional<float> r,
+                               sol::optional<float> sx, sol::optional<float> sy,
+                               sol::optional<float> ox, sol::optional<float> oy) {
+    SpriteBatch::Sprite sprite;
+    sprite.x = x;
+    sprite.y = y;
+    sprite.rotation = r.value_or(0.0f);
+    sprite.sx = sx.value_or(1.0f);
+    sprite.sy = sy.value_or(sprite.sx);
+    sprite.ox = ox.value_or(0.0f);
+    sprite.oy = oy.value_or(0.0f);
+    sprite.color = batch.getColor();
+    return sprite;
+}
+
+// Resolves an image argument given either as a handle or, for compatibility, by name. Objects
+// keep the handle; it is invalid when nothing by that name or handle is loaded.
+ImageHandle resolveImageHandle(Graphics& g, const sol::object& image) {
+    ImageHandle handle;
+    if (image.is<ImageHandle>()) {
+        handle = image.as<ImageHandle>();
+    } else if (image.is<std::string>()) {
+        handle = g.findImage(image.as<std::string>());
+    }
+    return g.getImage(handle) ? handle : ImageHandle{};
+}
+
+// Registry slot holding the bound canvas, so a target the script stops referencing stays alive
+constexpr const char* CURRENT_CANVAS_KEY = "tsuki.graphics.canvas";
+
+// Registry slot holding the active camera, so Graphics never reads one the script let go of
+constexpr const char* CURRENT_CAMERA_KEY = "tsuki.graphics.camera";
+
+// LuaJIT's type tag for cdata, which lua.h does not name
+constexpr int LUA_TYPE_CDATA = 10;
+
+// Registry slot caching the ffi module once it has been looked up
+constexpr const char* FFI_KEY = "tsuki.ffi";
+
+// Length in floats of an FFI float array (float[n] or float[?]), or 0 for any other cdata.
+// Pointers are refused: their extent is unknown, and lua_topointer on a pointer cdata gives
+// the address of the pointer itself rather than what it points to.
+size_t ffiFloatArrayLength(lua_State* L, const sol::object& data) {
+    sol::state_view lua_view(L);
+    sol::object ffi = lua_view.registry()[FFI_KEY];
+    if (ffi.get_type() != sol::type::table) {
+        sol::protected_function require = lua_view["require"];
+        sol::protected_function_result result = require("ffi");
+        if (!result.valid()) {
+            return 0;
+        }
+        ffi = result.get<sol::object>();
+        lua_view.registry()[FFI_KEY] = ffi;
+    }
+
+    sol::table module = ffi.as<sol::table>();
+    sol::function type_of = module["typeof"];
+    sol::function size_of = module["sizeof"];
+    sol::function to_string = lua_view["tostring"];
+
+    sol::object ctype = type_of(data);
+    const std::string type = to_string(ctype);
+    if (type.rfind("ctype<float [", 0) != 0 && type.rfind("ctype<const float [", 0) != 0) {
+        return 0;
+    }
+    sol::optional<double> bytes = size_of(data);
+    return bytes ? static_cast<size_t>(*bytes) / sizeof(float) : 0;
+}
+
+// Reads a flat float array for the bulk drawing calls. Tables are copied into the graphics
+// scratch buffer; an FFI float array is read in place. Either is clamped to its length,
+// which count may shorten.
+const float* readFloatArray(std::vector<float>& scratch, sol::this_state s, const sol::object& data,
+                            sol::optional<int> count, size_t* length) {
+    *length = 0;
+
+    if (data.get_type() == sol::type::table) {
+        sol::table values = data.as<sol::table>();
+        size_t n = values.size();
+        if (count) {
+            n = std::min(n, static_cast<size_t>(std::max(0, *count)));
+        }
+        scratch.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            scratch[i] = values.raw_get_or<float>(i + 1, 0.0f);
+        }
+        *length = n;
+        return scratch.data();
+    }
+
+    lua_State* L = s;
+    data.push(L);
+    const bool cdata = lua_type(L, -1) == LUA_TYPE_CDATA;
+    const void* pointer = cdata ? lua_topointer(L, -1) : nullptr;
+    lua_pop(L, 1);
+    if (!pointer) {
+        return nullptr;
+    }
+
+    size_t available = ffiFloatArrayLength(L, data);
+    if (count) {
+        available = std::min(available, static_cast<size_t>(std::max(0, *count)));
+    }
+    if (available == 0) {
+        return nullptr;
+    }
+    *length = available;
+    return static_cast<const float*>(pointer);
+}
+
+} // namespace
+
 void LuaBindings::registerAll(sol::state& lua, Engine* engine) {
 
     // Bind enums
@@ -49,27 +166,585 @@ void LuaBindings::registerAll(sol::state& lua, Engine* engine) {
         "setColor", [](Graphics& g, float r, float g_, float b, float a) {
             g.setColor(Color(r, g_, b, a));
         },
+        "setLineWidth", &Graphics::setLineWidth,
+        "getLineWidth", &Graphics::getLineWidth,
+        "setLineJoin", [](Graphics& g, const std::string& join) {
+            if (join == "bevel") {
+                g.setLineJoin(LineJoin::Bevel);
+            } else if (join == "none") {
+                g.setLineJoin(LineJoin::None);
+            } else {
+                g.setLineJoin(LineJoin::Miter);
+            }
+        },
+        "getLineJoin", [](Graphics& g) -> std::string {
+            switch (g.getLineJoin()) {
+                case LineJoin::Bevel: return "bevel";
+                case LineJoin::None: return "none";
+                default: return "miter";
+            }
+        },
         "rectangle", [](Graphics& g, const std::string& mode, float x, float y, float w, float h) {
             DrawMode dm = (mode == "fill") ? DrawMode::Fill : DrawMode::Line;
             g.rectangle(dm, x, y, w, h);
         },
-        "circle", [](Graphics& g, const std::string& mode, float x, float y, float radius) {
+        "circle", [](Graphics& g, const std::string& mode, float x, float y, float radius,
+                     sol::optional<int> segments) {
             DrawMode dm = (mode == "fill") ? DrawMode::Fill : DrawMode::Line;
-            g.circle(dm, x, y, radius);
+            g.circle(dm, x, y, radius, segments.value_or(0));
         },
         "line", &Graphics::line,
         "point", &Graphics::point,
+        "polygon", sol::overload(
+            [](Graphics& g, const std::string& mode, const Shape& shape) {
+                DrawMode dm = (mode == "fill") ? DrawMode::Fill : DrawMode::Line;
+                g.polygon(dm, shape);
+            },
+            [](Graphics& g, const std::string& mode, const sol::table& points) {
+                std::vector<float> coords(points.size());
+                for (size_t i = 0; i < coords.size(); ++i) {
+                    coords[i] = points.raw_get_or<float>(i + 1, 0.0f);
+                }
+                DrawMode dm = (mode == "fill") ? DrawMode::Fill : DrawMode::Line;
+                g.polygon(dm, coords);
+            }
+        ),
+        "newShape", [](Graphics& g, const sol::object& data, sol::optional<int> count,
+                       sol::this_state s) -> std::unique_ptr<Shape> {
+            size_t length;
+            const float* values = readFloatArray(g.getScratchFloats(), s, data, count, &length);
+            auto shape = std::make_unique<Shape>();
+            if (values) {
+                shape->setPoints(values, length / 2);
+            }
+            return shape;
+        },
+
+        // Bulk drawing: a flat number table, or an FFI float[n] / float[?] array. The optional
+        // count, in floats, may shorten the array but never reads past it.
+        "points", [](Graphics& g, const sol::object& data, sol::optional<int> count, sol::this_state s) {
+            size_t length;
+            const float* values = readFloatArray(g.getScratchFloats(), s, data, count, &length);
+            g.points(values, length / 2);
+        },
+        "lines", [](Graphics& g, const sol::object& data, sol::optional<int> count, sol::this_state s) {
+            size_t length;
+            const float* values = readFloatArray(g.getScratchFloats(), s, data, count, &length);
+            g.lines(values, length / 2);
+        },
+        "polyline", [](Graphics& g, const sol::object& data, sol::optional<int> count, sol::this_state s) {
+            size_t length;
+            const float* values = readFloatArray(g.getScratchFloats(), s, data, count, &length);
+            g.polyline(values, length / 2);
+        },
+        "rectangles", [](Graphics& g, const std::string& mode, const sol::object& data,
+                         sol::optional<int> count, sol::this_state s) {
+            size_t length;
+            const float* values = readFloatArray(g.getScratchFloats(), s, data, count, &length);
+            DrawMode dm = (mode == "fill") ? DrawMode::Fill : DrawMode::Line;
+            g.rectangles(dm, values, length / 4);
+        },
+        "triangles", [](Graphics& g, const sol::object& data, sol::optional<int> count, sol::this_state s) {
+            size_t length;
+            const float* values = readFloatArray(g.getScratchFloats(), s, data, count, &length);
+            g.triangles(values, length / 6);
+        },
+
+        // Transform functions
+        "push", &Graphics::push,
+        "pop", &Graphics::pop,
+        "translate", &Graphics::translate,
+        "rotate", &Graphics::rotate,
+        "scale", &Graphics::scale,
+        "origin", &Graphics::origin,
+        "transformPoint", &Graphics::transformPoint,
+        "inverseTransformPoint", &Graphics::inverseTransformPoint,
 
         // Text functions
         "print", sol::resolve<void(const std::string&, float, float)>(&Graphics::print),
+        "printf", [](Graphics& g, const std::string& text, float x, float y, float limit,
+                     sol::optional<std::string> align) {
+            g.printf(text, x, y, limit, align.value_or("left"));
+        },
         "getTextSize", &Graphics::getTextSize,
-        "loadFont", &Graphics::loadFont,
+        "loadFont", [](Graphics& g, const std::string& name, const std::string& filename,
+                       sol::optional<float> size, sol::optional<bool> sdf) {
+            return g.loadFont(name, filename, size.value_or(16.0f), sdf.value_or(false));
+        },
         "setFont", &Graphics::setFont,
+        "setFontFallbacks", [](Graphics& g, const std::string& name, const sol::table& fallbacks) {
+            std::vector<std::string> names;
+            for (size_t i = 1; i <= fallbacks.size(); ++i) {
+                names.push_back(fallbacks.get<std::string>(i));
+            }
+            return g.setFontFallbacks(name, names);
+        },
 
         // Image functions
-        "loadImage", &Graphics::loadImage,
-        "unloadImage", &Graphics::unloadImage,
-        "draw", sol::resolve<void(const std::string&, float, float)>(&Graphics::draw)
+        "loadImage", [](Graphics& g, const std::string& name,
+                        const std::string& filename) -> sol::optional<ImageHandle> {
+            ImageHandle handle = g.loadImage(name, filename);
+            if (!handle) {
+                return sol::nullopt;
+            }
+            return handle;
+        },
+        "unloadImage", sol::overload(
+            sol::resolve<bool(ImageHandle)>(&Graphics::unloadImage),
+            sol::resolve<bool(const std::string&)>(&Graphics::unloadImage)
+        ),
+        "getImage", [](Graphics& g, const std::string& name) -> sol::optional<ImageHandle> {
+            ImageHandle handle = g.findImage(name);
+            if (!handle) {
+                return sol::nullopt;
+            }
+            return handle;
+        },
+        "loadImageAsync", &Graphics::loadImageAsync,
+        "setImageUploadBudget", &Graphics::setImageUploadBudget,
+        "getImageUploadBudget", &Graphics::getImageUploadBudget,
+        "getImageLoadProgress", [](Graphics& g, sol::this_state s) {
+            sol::state_view lua_view(s);
+            ImageLoadProgress progress = g.getImageLoadProgress();
+            return lua_view.create_table_with(
+                "total", progress.total,
+                "completed", progress.completed,
+                "failed", progress.failed,
+                "fraction", progress.fraction
+            );
+        },
+        "setTextureBudget", [](Graphics& g, double bytes) {
+            g.setTextureBudget(bytes > 0.0 ? static_cast<size_t>(bytes) : 0);
+        },
+        "getTextureBudget", [](Graphics& g) {
+            return static_cast<double>(g.getTextureBudget());
+        },
+        "getTextureStats", [](Graphics& g, sol::this_state s) {
+            sol::state_view lua_view(s);
+            TextureStats stats = g.getTextureStats();
+            return lua_view.create_table_with(
+                "residentBytes", static_cast<double>(stats.residentBytes),
+                "budgetBytes", static_cast<double>(stats.budgetBytes),
+                "residentImages", stats.residentImages,
+                "evictedImages", stats.evictedImages,
+                "evictions", stats.evictions,
+                "reloads", stats.reloads
+            );
+        },
+        "draw", sol::overload(
+            [](Graphics& g, const ImageHandle& image, float x, float y) {
+                g.draw(image, x, y);
+            },
+            [](Graphics& g, const ImageHandle& image, float x, float y, float r, float sx, float sy,
+               float ox, float oy) {
+                g.draw(image, x, y, r, sx, sy, ox, oy);
+            },
+            sol::resolve<void(const std::string&, float, float)>(&Graphics::draw),
+            [](Graphics& g, const Canvas& canvas, float x, float y) {
+                g.draw(canvas, x, y);
+            },
+            [](Graphics& g, SpriteBatch& batch) {
+                g.draw(batch);
+            },
+            [](Graphics& g, SpriteBatch& batch, float x, float y) {
+                g.draw(batch, x, y);
+            },
+            [](Graphics& g, const Mesh& mesh) {
+                g.draw(mesh);
+            },
+            [](Graphics& g, const Mesh& mesh, float x, float y) {
+                g.draw(mesh, x, y);
+            },
+            [](Graphics& g, Tilemap& tilemap) {
+                g.draw(tilemap);
+            },
+            [](Graphics& g, Tilemap& tilemap, float x, float y) {
+                g.draw(tilemap, x, y);
+            },
+            [](Graphics& g, Tilemap& tilemap, float x, float y, int layer) {
+                // Out of range layers draw nothing rather than falling back to all of them
+                g.draw(tilemap, x, y, layer >= 1 ? layer - 1 : tilemap.getLayerCount());
+            },
+            [](Graphics& g, ParticleSystem& particles) {
+                g.draw(particles);
+            },
+            [](Graphics& g, ParticleSystem& particles, float x, float y) {
+                g.draw(particles, x, y);
+            }
+        ),
+        // Canvas functions
+        "newCanvas", [](Graphics& g, int width, int height) {
+            return g.newCanvas(width, height);
+        },
+        "setCanvas", [](Graphics& g, sol::optional<sol::object> canvas, sol::this_state s) {
+            Canvas* target = (canvas && canvas->is<Canvas>()) ? &canvas->as<Canvas&>() : nullptr;
+            g.setCanvas(target);
+            sol::state_view lua_view(s);
+            if (g.getCanvas()) {
+                lua_view.registry()[CURRENT_CANVAS_KEY] = *canvas;
+            } else {
+                lua_view.registry()[CURRENT_CANVAS_KEY] = sol::lua_nil;
+            }
+        },
+        "getCanvas", [](Graphics& g, sol::this_state s) -> sol::object {
+            sol::state_view lua_view(s);
+            sol::object bound = lua_view.registry()[CURRENT_CANVAS_KEY];
+            if (!g.getCanvas() || !bound.is<Canvas>() || &bound.as<Canvas&>() != g.getCanvas()) {
+                return sol::lua_nil;
+            }
+            return bound;
+        },
+        "acquireCanvas", &Graphics::acquireCanvas,
+        "releaseCanvas", &Graphics::releaseCanvas,
+
+        "newTilemap", [](Graphics& g, const sol::object& tileset, int tileWidth, int tileHeight,
+                         int width, int height, sol::optional<int> layers) -> std::unique_ptr<Tilemap> {
+            ImageHandle image = resolveImageHandle(g, tileset);
+            if (!image) {
+                return nullptr;
+            }
+            return std::make_unique<Tilemap>(image, tileWidth, tileHeight, width, height, layers.value_or(1));
+        },
+
+        "newParticleSystem", [](Graphics& g, int maxParticles,
+                                sol::optional<sol::object> texture) -> std::unique_ptr<ParticleSystem> {
+            ImageHandle image = texture ? resolveImageHandle(g, *texture) : ImageHandle{};
+            return std::make_unique<ParticleSystem>(static_cast<size_t>(std::max(1, maxParticles)), image);
+        },
+
+        "setScissor", [](Graphics& g, sol::optional<int> x, sol::optional<int> y,
+                         sol::optional<int> width, sol::optional<int> height) {
+            if (x && y && width && height) {
+                g.setScissor(*x, *y, *width, *height);
+            } else {
+                g.setScissor();
+            }
+        },
+        "getRenderStateStats", [](Graphics& g, sol::this_state s) {
+            sol::state_view lua_view(s);
+            RenderStateStats stats = g.getRenderStateStats();
+            return lua_view.create_table_with(
+                "issued", stats.issued,
+                "skipped", stats.skipped
+            );
+        },
+
+        // Camera functions
+        "newCamera", [](Graphics&) {
+            return std::make_unique<Camera>();
+        },
+        "setCamera", [](Graphics& g, sol::optional<sol::object> camera, sol::this_state s) {
+            const Camera* active = (camera && camera->is<Camera>()) ? &camera->as<Camera&>() : nullptr;
+            g.setCamera(active);
+            sol::state_view lua_view(s);
+            if (active) {
+                lua_view.registry()[CURRENT_CAMERA_KEY] = *camera;
+            } else {
+                lua_view.registry()[CURRENT_CAMERA_KEY] = sol::lua_nil;
+            }
+        },
+        "getCamera", [](Graphics& g, sol::this_state s) -> sol::object {
+            sol::state_view lua_view(s);
+            sol::object active = lua_view.registry()[CURRENT_CAMERA_KEY];
+            if (!g.getCamera() || !active.is<Camera>() || &active.as<Camera&>() != g.getCamera()) {
+                return sol::lua_nil;
+            }
+            return active;
+        },
+        "getCullStats", [](Graphics& g, sol::this_state s) {
+            sol::state_view lua_view(s);
+            return lua_view.create_table_with("culled", g.getCullStats().culled);
+        },
+
+        // Logical and dynamic resolution
+        "setLogicalSize", [](Graphics& g, int width, int height, sol::optional<bool> integerScale) {
+            g.setLogicalSize(width, height, integerScale.value_or(false));
+        },
+        "getLogicalSize", &Graphics::getLogicalSize,
+        "toLogical", &Graphics::toLogical,
+        "setRenderScale", &Graphics::setRenderScale,
+        "getRenderScale", &Graphics::getRenderScale,
+        "setDynamicResolution", [](Graphics& g, bool enabled, sol::optional<float> frameBudgetMs,
+                                   sol::optional<float> minScale) {
+            g.setDynamicResolution(enabled, frameBudgetMs.value_or(1000.0f / 60.0f), minScale.value_or(0.5f));
+        },
+        "isDynamicResolution", &Graphics::isDynamicResolution,
+
+        // Deferred draw queue
+        "setDeferred", &Graphics::setDeferred,
+        "isDeferred", &Graphics::isDeferred,
+        "setLayer", &Graphics::setLayer,
+        "getLayer", &Graphics::getLayer,
+        "setDepth", &Graphics::setDepth,
+        "getDepth", &Graphics::getDepth,
+        "getDrawQueueStats", [](Graphics& g, sol::this_state s) {
+            sol::state_view lua_view(s);
+            DrawQueueStats stats = g.getDrawQueueStats();
+            return lua_view.create_table_with(
+                "items", stats.items,
+                "batches", stats.batches,
+                "batchesSaved", stats.batchesSaved
+            );
+        },
+        "getAtlasStats", [](Graphics& g, sol::this_state s) {
+            sol::state_view lua_view(s);
+            sol::table pages = lua_view.create_table();
+            int index = 1;
+            for (const auto& page : g.getAtlasStats()) {
+                pages[index++] = lua_view.create_table_with(
+                    "width", page.width,
+                    "height", page.height,
+                    "images", page.imageCount,
+                    "usage", page.usage
+                );
+            }
+            return pages;
+        },
+        "newSpriteBatch", [](Graphics& g, const sol::object& texture,
+                             sol::optional<int> capacity) -> std::unique_ptr<SpriteBatch> {
+            ImageHandle image = resolveImageHandle(g, texture);
+            if (!image) {
+                return nullptr;
+            }
+            return std::make_unique<SpriteBatch>(image, static_cast<size_t>(std::max(1, capacity.value_or(1000))));
+        },
+        "newMesh", [](Graphics& g, int vertexCount, sol::optional<sol::object> texture) -> std::unique_ptr<Mesh> {
+            ImageHandle image = texture ? resolveImageHandle(g, *texture) : ImageHandle{};
+            return std::make_unique<Mesh>(static_cast<size_t>(std::max(0, vertexCount)), image);
+        }
+    );
+
+    // Bind ImageHandle; opaque on the Lua side, resolved through tsuki.graphics
+    lua.new_usertype<ImageHandle>("Image",
+        sol::no_constructor
+    );
+
+    // Bind ImageLoad; polled from Lua until done
+    lua.new_usertype<ImageLoad>("ImageLoad",
+        sol::no_constructor,
+        "isDone", &ImageLoad::isDone,
+        "isReady", [](const ImageLoad& l) { return l.getState() == ImageLoad::State::Ready; },
+        "isFailed", [](const ImageLoad& l) { return l.getState() == ImageLoad::State::Failed; },
+        "getImage", [](const ImageLoad& l) -> sol::optional<ImageHandle> {
+            if (l.getState() != ImageLoad::State::Ready) {
+                return sol::nullopt;
+            }
+            return l.getImage();
+        },
+        "getName", &ImageLoad::getName
+    );
+
+    // Bind Camera class
+    lua.new_usertype<Camera>("Camera",
+        sol::no_constructor,
+        "setPosition", &Camera::setPosition,
+        "getPosition", &Camera::getPosition,
+        "move", &Camera::move,
+        "setZoom", &Camera::setZoom,
+        "getZoom", &Camera::getZoom,
+        "setRotation", &Camera::setRotation,
+        "getRotation", &Camera::getRotation,
+        "setViewport", [](Camera& c, sol::optional<int> x, sol::optional<int> y,
+                          sol::optional<int> width, sol::optional<int> height) {
+            if (x && y && width && height) {
+                c.setViewport(*x, *y, *width, *height);
+            } else {
+                c.clearViewport();
+            }
+        },
+        "getViewport", [](const Camera& c) -> std::tuple<sol::optional<int>, sol::optional<int>,
+                                                         sol::optional<int>, sol::optional<int>> {
+            if (!c.hasViewport()) {
+                return {sol::nullopt, sol::nullopt, sol::nullopt, sol::nullopt};
+            }
+            const SDL_Rect viewport = c.getViewport();
+            return {viewport.x, viewport.y, viewport.w, viewport.h};
+        }
+    );
+
+    // Bind Canvas class
+    lua.new_usertype<Canvas>("Canvas",
+        sol::no_constructor,
+        "getWidth", &Canvas::getWidth,
+        "getHeight", &Canvas::getHeight
+    );
+
+    // Bind Tilemap class (layers and tile coordinates are 1-based on the Lua side)
+    lua.new_usertype<Tilemap>("Tilemap",
+        sol::no_constructor,
+        "setTile", [](Tilemap& t, int layer, int x, int y, int tile) {
+            t.setTile(layer - 1, x - 1, y - 1, tile);
+        },
+        "getTile", [](const Tilemap& t, int layer, int x, int y) {
+            return t.getTile(layer - 1, x - 1, y - 1);
+        },
+        "setTiles", [](Tilemap& t, int layer, const sol::table& tiles) {
+            // Flat row-major array of tile ids covering the whole layer
+            const int count = t.getWidth() * t.getHeight();
+            for (int i = 0; i < count; ++i) {
+                t.setTile(layer - 1, i % t.getWidth(), i / t.getWidth(), tiles.get_or(i + 1, 0));
+            }
+        },
+        "fill", [](Tilemap& t, int layer, int tile) {
+            t.fill(layer - 1, tile);
+        },
+        "getWidth", &Tilemap::getWidth,
+        "getHeight", &Tilemap::getHeight,
+        "getLayerCount", &Tilemap::getLayerCount
+    );
+
+    // Bind ParticleSystem class
+    lua.new_usertype<ParticleSystem>("ParticleSystem",
+        sol::no_constructor,
+        "setPosition", &ParticleSystem::setPosition,
+        "setEmissionArea", &ParticleSystem::setEmissionArea,
+        "setEmissionRate", &ParticleSystem::setEmissionRate,
+        "setLifetime", &ParticleSystem::setLifetime,
+        "setDirection", &ParticleSystem::setDirection,
+        "setSpread", &ParticleSystem::setSpread,
+        "setSpeed", &ParticleSystem::setSpeed,
+        "setGravity", &ParticleSystem::setGravity,
+        "setDamping", &ParticleSystem::setDamping,
+        "setSizes", [](ParticleSystem& p, sol::variadic_args args) {
+            std::vector<float> sizes;
+            for (auto arg : args) {
+                sizes.push_back(arg.as<float>());
+            }
+            p.setSizes(sizes);
+        },
+        "setColors", [](ParticleSystem& p, sol::variadic_args args) {
+            // Flat list of r, g, b, a groups
+            std::vector<Color> colors;
+            std::vector<float> values;
+            for (auto arg : args) {
+                values.push_back(arg.as<float>());
+            }
+            for (size_t i = 0; i + 3 < values.size(); i += 4) {
+                colors.emplace_back(values[i], values[i + 1], values[i + 2], values[i + 3]);
+            }
+            p.setColors(colors);
+        },
+        "emit", [](ParticleSystem& p, int count) {
+            p.emit(static_cast<size_t>(std::max(0, count)));
+        },
+        "start", &ParticleSystem::start,
+        "stop", &ParticleSystem::stop,
+        "reset", &ParticleSystem::reset,
+        "isActive", &ParticleSystem::isActive,
+        "update", &ParticleSystem::update,
+        "getCount", [](const ParticleSystem& p) {
+            return static_cast<int>(p.getCount());
+        }
+    );
+
+    // Bind SpriteBatch class (ids are 1-based on the Lua side)
+    lua.new_usertype<SpriteBatch>("SpriteBatch",
+        sol::no_constructor,
+        "add", [](SpriteBatch& b, float x, float y, sol::optional<float> r, sol::optional<float> sx,
+                  sol::optional<float> sy, sol::optional<float> ox, sol::optional<float> oy) {
+            return b.add(makeSprite(b, x, y, r, sx, sy, ox, oy)) + 1;
+        },
+        "addRect", [](SpriteBatch& b, float qx, float qy, float qw, float qh, float x, float y,
+                      sol::optional<float> r, sol::optional<float> sx, sol::optional<float> sy,
+                      sol::optional<float> ox, sol::optional<float> oy) {
+            auto sprite = makeSprite(b, x, y, r, sx, sy, ox, oy);
+            sprite.source = {qx, qy, qw, qh};
+            return b.add(sprite) + 1;
+        },
+        "set", [](SpriteBatch& b, int id, float x, float y, sol::optional<float> r, sol::optional<float> sx,
+                  sol::optional<float> sy, sol::optional<float> ox, sol::optional<float> oy) {
+            return b.set(id - 1, makeSprite(b, x, y, r, sx, sy, ox, oy));
+        },
+        "setRect", [](SpriteBatch& b, int id, float qx, float qy, float qw, float qh, float x, float y,
+                      sol::optional<float> r, sol::optional<float> sx, sol::optional<float> sy,
+                      sol::optional<float> ox, sol::optional<float> oy) {
+            auto sprite = makeSprite(b, x, y, r, sx, sy, ox, oy);
+            sprite.source = {qx, qy, qw, qh};
+            return b.set(id - 1, sprite);
+        },
+        "setColor", [](SpriteBatch& b, float r, float g, float b_, float a) {
+            b.setColor(Color(r, g, b_, a));
+        },
+        "clear", &SpriteBatch::clear,
+        "getCount", [](const SpriteBatch& b) {
+            return static_cast<int>(b.getCount());
+        }
+    );
+
+    // Bind Shape class (hole indices are 1-based on the Lua side)
+    lua.new_usertype<Shape>("Shape",
+        sol::no_constructor,
+        "setPoints", [engine](Shape& shape, const sol::object& data, sol::optional<int> count, sol::this_state s) {
+            size_t length;
+            std::vector<float>& scratch = engine->getGraphics().getScratchFloats();
+            const float* values = readFloatArray(scratch, s, data, count, &length);
+            shape.setPoints(values, values ? length / 2 : 0);
+        },
+        "addHole", [engine](Shape& shape, const sol::object& data, sol::optional<int> count,
+                            sol::this_state s) -> sol::optional<int> {
+            size_t length;
+            std::vector<float>& scratch = engine->getGraphics().getScratchFloats();
+            const float* values = readFloatArray(scratch, s, data, count, &length);
+            if (!values || length < 6) {
+                return sol::nullopt;
+            }
+            return shape.addHole(values, length / 2) + 1;
+        },
+        "clearHoles", &Shape::clearHoles,
+        "getHoleCount", [](const Shape& shape) {
+            return static_cast<int>(shape.getHoleCount());
+        },
+        "getTriangleCount", [](const Shape& shape) {
+            return static_cast<int>(shape.getTriangles().size() / 3);
+        }
+    );
+
+    // Bind Mesh class (vertex indices are 1-based on the Lua side)
+    lua.new_usertype<Mesh>("Mesh",
+        sol::no_constructor,
+        "setVertices", [engine](Mesh& m, sol::this_state s, int start, const sol::object& data,
+                                sol::optional<int> count) {
+            if (start < 1) {
+                return false;
+            }
+
+            // More vertices than the mesh holds can never fit; the rest is counted in size_t
+            sol::optional<int> floats;
+            if (count) {
+                if (*count < 0 || static_cast<size_t>(*count) > m.getVertexCount()) {
+                    return false;
+                }
+                floats = static_cast<int>(std::min(static_cast<size_t>(*count) * Mesh::FLOATS_PER_VERTEX,
+                                                   static_cast<size_t>(INT_MAX)));
+            }
+            size_t length = 0;
+            std::vector<float>& scratch = engine->getGraphics().getScratchFloats();
+            const float* values = readFloatArray(scratch, s, data, floats, &length);
+            return m.setVertices(static_cast<size_t>(start - 1), values, length / Mesh::FLOATS_PER_VERTEX);
+        },
+        "setVertex", [](Mesh& m, int index, float x, float y, float u, float v, sol::optional<float> r,
+                        sol::optional<float> g, sol::optional<float> b, sol::optional<float> a) {
+            const Color color(r.value_or(1.0f), g.value_or(1.0f), b.value_or(1.0f), a.value_or(1.0f));
+            return index >= 1 && m.setVertex(static_cast<size_t>(index - 1), x, y, u, v, color);
+        },
+        "setIndices", [](Mesh& m, sol::optional<sol::table> indices) {
+            std::vector<int> values;
+            if (indices) {
+                values.reserve(indices->size());
+                for (size_t i = 1; i <= indices->size(); ++i) {
+                    values.push_back(indices->raw_get_or<int>(i, 0) - 1);
+                }
+            }
+            return m.setIndices(values.data(), values.size());
+        },
+        "setImage", [engine](Mesh& m, sol::optional<sol::object> texture) {
+            ImageHandle image = (engine && texture) ? resolveImageHandle(engine->getGraphics(), *texture)
+                                                    : ImageHandle{};
+            m.setImage(image);
+        },
+        "getVertexCount", [](const Mesh& m) {
+            return static_cast<int>(m.getVertexCount());
+        }
     );
 
     // Bind Keyboard class
@@ -0,0 +1,85 @@
+#include "tsuki/mesh.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace tsuki {
+
+Mesh::Mesh(size_t vertexCount, ImageHandle image)
+    : image_(image),
+      vertices_(vertexCount, SDL_Vertex{{0.0f, 0.0f}, {1.0f, 1.0f, 1.0f, 1.0f}, {0.0f, 0.0f}}) {
+    resetIndices();
+}
+
+bool Mesh::setVertices(size_t start, const float* data, size_t count) {
+    if (!data || start > vertices_.size() || count > vertices_.size() - start) {
+        return false;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        const float* v = data + i * FLOATS_PER_VERTEX;
+        vertices_[start + i] = {{v[0], v[1]}, {v[4], v[5], v[6], v[7]}, {v[2], v[3]}};
+    }
+    bounds_dirty_ = true;
+    return true;
+}
+
+bool Mesh::setVertex(size_t index, float x, float y, float u, float v, const Color& color) {
+    if (index >= vertices_.size()) {
+        return false;
+    }
+
+    vertices_[index] = {{x, y}, {color.r, color.g, color.b, color.a}, {u, v}};
+    bounds_dirty_ = true;
+    return true;
+}
+
+bool Mesh::setIndices(const int* indices, size_t count) {
+    if (count == 0) {
+        resetIndices();
+        return true;
+    }
+
+    if (!indices || count % 3 != 0) {
+        return false;
+    }
+
+    const int vertexCount = static_cast<int>(vertices_.size());
+    for (size_t i = 0; i < count; ++i) {
+        if (indices[i] < 0 || indices[i] >= vertexCount) {
+            return false;
+        }
+    }
+
+    indices_.assign(indices, indices + count);
+    return true;
+}
+
+void Mesh::getBounds(float* x0, float* y0, float* x1, float* y1) const {
+    if (bounds_dirty_) {
+        float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+        for (const SDL_Vertex& v : vertices_) {
+            minX = std::min(minX, v.position.x);
+            minY = std::min(minY, v.position.y);
+            maxX = std::max(maxX, v.position.x);
+            maxY = std::max(maxY, v.position.y);
+        }
+        bounds_ = vertices_.empty() ? SDL_FRect{0.0f, 0.0f, 0.0f, 0.0f} : SDL_FRect{minX, minY, maxX, maxY};
+        bounds_dirty_ = false;
+    }
+
+    *x0 = bounds_.x;
+    *y0 = bounds_.y;
+    *x1 = bounds_.w;
+    *y1 = bounds_.h;
+}
+
+void Mesh::resetIndices() {
+    // Default triangle list; a trailing partial triangle is left out
+    const size_t count = vertices_.size() - vertices_.size() % 3;
+    indices_.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        indices_[i] = static_cast<int>(i);
+    }
+}
+
+} // namespace tsuki
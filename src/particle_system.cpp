@@ -0,0 +1,217 @@
+#include "tsuki/particle_system.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace tsuki {
+
+ParticleSystem::ParticleSystem(size_t maxParticles, ImageHandle image)
+    : max_particles_(maxParticles), image_(image), rng_(std::random_device{}()) {
+    x_.resize(max_particles_);
+    y_.resize(max_particles_);
+    vx_.resize(max_particles_);
+    vy_.resize(max_particles_);
+    age_.resize(max_particles_);
+    age_rate_.resize(max_particles_);
+
+    setSizes({8.0f});
+    setColors({Color::white()});
+
+    // Quad indices never change, build them once for the full capacity
+    indices_.reserve(max_particles_ * 6);
+    for (size_t i = 0; i < max_particles_; ++i) {
+        int base = static_cast<int>(i * 4);
+        indices_.insert(indices_.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+    }
+    vertices_.reserve(max_particles_ * 4);
+}
+
+void ParticleSystem::setLifetime(float min, float max) {
+    lifetime_min_ = std::max(0.001f, std::min(min, max));
+    lifetime_max_ = std::max(lifetime_min_, std::max(min, max));
+}
+
+void ParticleSystem::setSpeed(float min, float max) {
+    speed_min_ = std::min(min, max);
+    speed_max_ = std::max(min, max);
+}
+
+void ParticleSystem::setSizes(const std::vector<float>& sizes) {
+    if (sizes.empty()) {
+        return;
+    }
+
+    // Bake the stops into a fixed table so the per-particle lookup is a single index
+    for (int i = 0; i < RAMP_SIZE; ++i) {
+        float t = static_cast<float>(i) / (RAMP_SIZE - 1) * (sizes.size() - 1);
+        size_t a = static_cast<size_t>(t);
+        size_t b = std::min(a + 1, sizes.size() - 1);
+        float f = t - a;
+        size_ramp_[i] = sizes[a] + (sizes[b] - sizes[a]) * f;
+    }
+}
+
+void ParticleSystem::setColors(const std::vector<Color>& colors) {
+    if (colors.empty()) {
+        return;
+    }
+
+    for (int i = 0; i < RAMP_SIZE; ++i) {
+        float t = static_cast<float>(i) / (RAMP_SIZE - 1) * (colors.size() - 1);
+        size_t a = static_cast<size_t>(t);
+        size_t b = std::min(a + 1, colors.size() - 1);
+        float f = t - a;
+        color_ramp_[i] = {
+            colors[a].r + (colors[b].r - colors[a].r) * f,
+            colors[a].g + (colors[b].g - colors[a].g) * f,
+            colors[a].b + (colors[b].b - colors[a].b) * f,
+            colors[a].a + (colors[b].a - colors[a].a) * f
+        };
+    }
+}
+
+void ParticleSystem::reset() {
+    count_ = 0;
+    emission_accumulator_ = 0.0f;
+}
+
+float ParticleSystem::random(float min, float max) {
+    if (max <= min) {
+        return min;
+    }
+    return std::uniform_real_distribution<float>(min, max)(rng_);
+}
+
+void ParticleSystem::emit(size_t count) {
+    count = std::min(count, max_particles_ - count_);
+
+    for (size_t n = 0; n < count; ++n) {
+        size_t i = count_++;
+
+        float angle = direction_ + random(-spread_ * 0.5f, spread_ * 0.5f);
+        float speed = random(speed_min_, speed_max_);
+
+        x_[i] = emitter_x_ + random(-area_width_ * 0.5f, area_width_ * 0.5f);
+        y_[i] = emitter_y_ + random(-area_height_ * 0.5f, area_height_ * 0.5f);
+        vx_[i] = std::cos(angle) * speed;
+        vy_[i] = std::sin(angle) * speed;
+        age_[i] = 0.0f;
+        age_rate_[i] = 1.0f / random(lifetime_min_, lifetime_max_);
+    }
+}
+
+void ParticleSystem::update(float dt) {
+    if (dt <= 0.0f) {
+        return;
+    }
+
+    const size_t n = count_;
+    const float damp = 1.0f / (1.0f + damping_ * dt);
+    const float gx = gravity_x_ * dt;
+    const float gy = gravity_y_ * dt;
+
+    float* __restrict x = x_.data();
+    float* __restrict y = y_.data();
+    float* __restrict vx = vx_.data();
+    float* __restrict vy = vy_.data();
+    float* __restrict age = age_.data();
+    const float* __restrict ageRate = age_rate_.data();
+
+    // Independent straight-line loops over each attribute
+    for (size_t i = 0; i < n; ++i) {
+        vx[i] = (vx[i] + gx) * damp;
+        vy[i] = (vy[i] + gy) * damp;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        age[i] += ageRate[i] * dt;
+    }
+
+    removeDead();
+
+    if (active_ && emission_rate_ > 0.0f) {
+        emission_accumulator_ += emission_rate_ * dt;
+        size_t spawn = static_cast<size_t>(emission_accumulator_);
+        emission_accumulator_ -= static_cast<float>(spawn);
+        emit(spawn);
+    }
+}
+
+void ParticleSystem::removeDead() {
+    // Swap-remove keeps the arrays dense; particle order doesn't matter
+    for (size_t i = 0; i < count_;) {
+        if (age_[i] < 1.0f) {
+            ++i;
+            continue;
+        }
+
+        size_t last = --count_;
+        x_[i] = x_[last];
+        y_[i] = y_[last];
+        vx_[i] = vx_[last];
+        vy_[i] = vy_[last];
+        age_[i] = age_[last];
+        age_rate_[i] = age_rate_[last];
+    }
+}
+
+void ParticleSystem::getBounds(float* x0, float* y0, float* x1, float* y1) const {
+    float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+    for (size_t i = 0; i < count_; ++i) {
+        minX = std::min(minX, x_[i]);
+        minY = std::min(minY, y_[i]);
+        maxX = std::max(maxX, x_[i]);
+        maxY = std::max(maxY, y_[i]);
+    }
+
+    // The largest size on the ramp bounds every particle's quad
+    float half = 0.0f;
+    for (float size : size_ramp_) {
+        half = std::max(half, std::fabs(size) * 0.5f);
+    }
+
+    *x0 = minX - half;
+    *y0 = minY - half;
+    *x1 = maxX + half;
+    *y1 = maxY + half;
+}
+
+const std::vector<SDL_Vertex>& ParticleSystem::buildVertices(const Image* image) {
+    vertices_.resize(count_ * 4);
+
+    // Trimmed atlas images only have texels over part of their area; that part keeps its
+    // place within the particle's square, as fractions of the full image
+    TextureQuad quad = {0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f};
+    if (image && image->isValid()) {
+        const float width = float(image->getWidth());
+        const float height = float(image->getHeight());
+        if (image->mapRegion({0.0f, 0.0f, width, height}, &quad)) {
+            quad.x0 /= width;
+            quad.x1 /= width;
+            quad.y0 /= height;
+            quad.y1 /= height;
+        }
+    }
+
+    SDL_Vertex* v = vertices_.data();
+    for (size_t i = 0; i < count_; ++i, v += 4) {
+        const int ramp = std::min(RAMP_SIZE - 1, static_cast<int>(age_[i] * (RAMP_SIZE - 1)));
+        const float size = size_ramp_[ramp];
+        const float left = x_[i] - size * 0.5f;
+        const float top = y_[i] - size * 0.5f;
+        const float x0 = left + quad.x0 * size, x1 = left + quad.x1 * size;
+        const float y0 = top + quad.y0 * size, y1 = top + quad.y1 * size;
+        const SDL_FColor& color = color_ramp_[ramp];
+
+        v[0] = {{x0, y0}, color, {quad.u0, quad.v0}};
+        v[1] = {{x1, y0}, color, {quad.u1, quad.v0}};
+        v[2] = {{x1, y1}, color, {quad.u1, quad.v1}};
+        v[3] = {{x0, y1}, color, {quad.u0, quad.v1}};
+    }
+
+    return vertices_;
+}
+
+} // namespace tsuki
@@ -0,0 +1,270 @@
+#include "tsuki/shape.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace tsuki {
+
+namespace {
+
+// Twice the signed area of triangle (o, a, b); positive when counter-clockwise in y-up terms
+float cross(const SDL_FPoint& o, const SDL_FPoint& a, const SDL_FPoint& b) {
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+float signedArea(const SDL_FPoint* points, size_t count) {
+    float area = 0.0f;
+    for (size_t i = 0, j = count - 1; i < count; j = i++) {
+        area += points[j].x * points[i].y - points[i].x * points[j].y;
+    }
+    return area * 0.5f;
+}
+
+bool samePoint(const SDL_FPoint& a, const SDL_FPoint& b) {
+    return a.x == b.x && a.y == b.y;
+}
+
+// Inclusive of the edges, for either winding
+bool pointInTriangle(const SDL_FPoint& a, const SDL_FPoint& b, const SDL_FPoint& c, const SDL_FPoint& p) {
+    const float d1 = cross(a, b, p);
+    const float d2 = cross(b, c, p);
+    const float d3 = cross(c, a, p);
+    const bool negative = d1 < 0.0f || d2 < 0.0f || d3 < 0.0f;
+    const bool positive = d1 > 0.0f || d2 > 0.0f || d3 > 0.0f;
+    return !(negative && positive);
+}
+
+} // namespace
+
+void Shape::setPoints(const float* coords, size_t count) {
+    // Holes stay behind the new outline
+    std::vector<SDL_FPoint> holes(points_.begin() + outline_count_, points_.end());
+
+    points_.clear();
+    for (size_t i = 0; i < count; ++i) {
+        points_.push_back({coords[i * 2], coords[i * 2 + 1]});
+    }
+
+    const long shift = static_cast<long>(count) - static_cast<long>(outline_count_);
+    for (size_t c = 1; c < contours_.size(); ++c) {
+        contours_[c] = static_cast<size_t>(static_cast<long>(contours_[c]) + shift);
+    }
+    if (contours_.empty()) {
+        contours_.push_back(0);
+    }
+
+    points_.insert(points_.end(), holes.begin(), holes.end());
+    outline_count_ = count;
+    dirty_ = true;
+}
+
+int Shape::addHole(const float* coords, size_t count) {
+    if (contours_.empty()) {
+        contours_.push_back(0);
+    }
+
+    contours_.push_back(points_.size());
+    for (size_t i = 0; i < count; ++i) {
+        points_.push_back({coords[i * 2], coords[i * 2 + 1]});
+    }
+    dirty_ = true;
+    return static_cast<int>(contours_.size()) - 2;
+}
+
+void Shape::clearHoles() {
+    points_.resize(outline_count_);
+    if (contours_.size() > 1) {
+        contours_.resize(1);
+    }
+    dirty_ = true;
+}
+
+const std::vector<int>& Shape::getTriangles() const {
+    if (dirty_) {
+        triangulate();
+        dirty_ = false;
+    }
+    return triangles_;
+}
+
+void Shape::getBounds(float* x0, float* y0, float* x1, float* y1) const {
+    float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+    for (size_t i = 0; i < outline_count_; ++i) {
+        minX = std::min(minX, points_[i].x);
+        minY = std::min(minY, points_[i].y);
+        maxX = std::max(maxX, points_[i].x);
+        maxY = std::max(maxY, points_[i].y);
+    }
+    *x0 = minX;
+    *y0 = minY;
+    *x1 = maxX;
+    *y1 = maxY;
+}
+
+// Holes are merged into the outline through bridge edges, turning the shape into one
+// weakly simple polygon that plain ear clipping can handle
+void Shape::triangulate() const {
+    triangles_.clear();
+    if (outline_count_ < 3) {
+        return;
+    }
+
+    // The outline is walked counter-clockwise and holes clockwise
+    std::vector<int> ring(outline_count_);
+    for (size_t i = 0; i < outline_count_; ++i) {
+        ring[i] = static_cast<int>(i);
+    }
+    if (signedArea(points_.data(), outline_count_) < 0.0f) {
+        std::reverse(ring.begin(), ring.end());
+    }
+
+    std::vector<std::vector<int>> holes;
+    for (size_t c = 1; c < contours_.size(); ++c) {
+        const size_t start = contours_[c];
+        const size_t end = (c + 1 < contours_.size()) ? contours_[c + 1] : points_.size();
+        if (end - start < 3) continue;
+
+        std::vector<int> hole;
+        for (size_t i = start; i < end; ++i) {
+            hole.push_back(static_cast<int>(i));
+        }
+        if (signedArea(&points_[start], end - start) > 0.0f) {
+            std::reverse(hole.begin(), hole.end());
+        }
+
+        // Start each hole at its rightmost point, where the bridge attaches
+        auto rightmost = std::max_element(hole.begin(), hole.end(), [this](int a, int b) {
+            return points_[a].x < points_[b].x;
+        });
+        std::rotate(hole.begin(), rightmost, hole.end());
+        holes.push_back(std::move(hole));
+    }
+
+    // Rightmost holes first, so each bridge can only cross into space already merged
+    std::sort(holes.begin(), holes.end(), [this](const std::vector<int>& a, const std::vector<int>& b) {
+        return points_[a[0]].x > points_[b[0]].x;
+    });
+    for (const std::vector<int>& hole : holes) {
+        bridgeHole(ring, hole);
+    }
+
+    clipEars(ring);
+}
+
+// Connects a hole to a ring vertex visible from the hole's rightmost point (Eberly's method)
+bool Shape::bridgeHole(std::vector<int>& ring, const std::vector<int>& hole) const {
+    const SDL_FPoint m = points_[hole[0]];
+    const size_t n = ring.size();
+
+    // Nearest edge crossed by a ray from m towards +x
+    float hitX = INFINITY;
+    size_t bridge = n;
+    for (size_t k = 0; k < n; ++k) {
+        const SDL_FPoint a = points_[ring[k]];
+        const SDL_FPoint b = points_[ring[(k + 1) % n]];
+        if (a.y == b.y || (a.y > m.y) == (b.y > m.y)) {
+            if (!(a.y == m.y && a.x >= m.x && a.x < hitX)) continue;
+            hitX = a.x;
+            bridge = k;
+            continue;
+        }
+
+        const float x = a.x + (m.y - a.y) * (b.x - a.x) / (b.y - a.y);
+        if (x >= m.x && x < hitX) {
+            hitX = x;
+            bridge = (a.x > b.x) ? k : (k + 1) % n;
+        }
+    }
+    if (bridge == n) {
+        return false; // Hole outside the outline
+    }
+
+    // Vertices inside the triangle (m, hit, candidate) would block the bridge; the one
+    // making the smallest angle with the ray is visible
+    const SDL_FPoint hit = {hitX, m.y};
+    const SDL_FPoint candidate = points_[ring[bridge]];
+    if (!samePoint(candidate, hit)) {
+        float bestTan = INFINITY;
+        for (size_t k = 0; k < n; ++k) {
+            const SDL_FPoint q = points_[ring[k]];
+            if (k == bridge || q.x <= m.x || !pointInTriangle(m, hit, candidate, q)) continue;
+
+            const float tan = std::fabs(q.y - m.y) / (q.x - m.x);
+            if (tan < bestTan || (tan == bestTan && q.x < points_[ring[bridge]].x)) {
+                bestTan = tan;
+                bridge = k;
+            }
+        }
+    }
+
+    // ... bridge, m, hole..., m, bridge ...
+    std::vector<int> splice(hole.begin(), hole.end());
+    splice.push_back(hole[0]);
+    splice.push_back(ring[bridge]);
+    ring.insert(ring.begin() + static_cast<long>(bridge) + 1, splice.begin(), splice.end());
+    return true;
+}
+
+void Shape::clipEars(const std::vector<int>& ring) const {
+    const size_t n = ring.size();
+    std::vector<size_t> prev(n), next(n);
+    for (size_t i = 0; i < n; ++i) {
+        prev[i] = (i + n - 1) % n;
+        next[i] = (i + 1) % n;
+    }
+    triangles_.reserve((n - 2) * 3);
+
+    auto unlink = [&](size_t i) {
+        next[prev[i]] = next[i];
+        prev[next[i]] = prev[i];
+    };
+
+    auto isEar = [&](size_t i) {
+        const SDL_FPoint a = points_[ring[prev[i]]];
+        const SDL_FPoint b = points_[ring[i]];
+        const SDL_FPoint c = points_[ring[next[i]]];
+        if (cross(a, b, c) <= 0.0f) {
+            return false; // Reflex
+        }
+        for (size_t k = next[next[i]]; k != prev[i]; k = next[k]) {
+            const SDL_FPoint p = points_[ring[k]];
+            if (samePoint(p, a) || samePoint(p, b) || samePoint(p, c)) continue;
+            if (pointInTriangle(a, b, c, p)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    size_t remaining = n;
+    size_t i = 0;
+    size_t stalled = 0;
+    while (remaining > 3) {
+        const SDL_FPoint a = points_[ring[prev[i]]];
+        const SDL_FPoint b = points_[ring[i]];
+        const SDL_FPoint c = points_[ring[next[i]]];
+
+        // Collinear vertices add no area and are dropped. If a full lap finds no ear the input
+        // self-intersects; clipping anyway still terminates with a best-effort fill.
+        const bool degenerate = cross(a, b, c) == 0.0f;
+        if (degenerate || isEar(i) || stalled > remaining) {
+            if (!degenerate) {
+                triangles_.push_back(ring[prev[i]]);
+                triangles_.push_back(ring[i]);
+                triangles_.push_back(ring[next[i]]);
+            }
+            unlink(i);
+            --remaining;
+            i = next[i];
+            stalled = 0;
+        } else {
+            i = next[i];
+            ++stalled;
+        }
+    }
+
+    triangles_.push_back(ring[prev[i]]);
+    triangles_.push_back(ring[i]);
+    triangles_.push_back(ring[next[i]]);
+}
+
+} // namespace tsuki
@@ -0,0 +1,119 @@
+#include "tsuki/sprite_batch.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace tsuki {
+
+SpriteBatch::SpriteBatch(ImageHandle image, size_t capacity)
+    : image_(image) {
+    sprites_.reserve(capacity);
+    vertices_.reserve(capacity * 4);
+    indices_.reserve(capacity * 6);
+}
+
+int SpriteBatch::add(const Sprite& sprite) {
+    size_t index = getCount();
+    sprites_.push_back(sprite);
+    vertices_.resize(vertices_.size() + 4);
+    markDirty(index);
+
+    int base = static_cast<int>(index * 4);
+    indices_.push_back(base);
+    indices_.push_back(base + 1);
+    indices_.push_back(base + 2);
+    indices_.push_back(base);
+    indices_.push_back(base + 2);
+    indices_.push_back(base + 3);
+
+    return static_cast<int>(index);
+}
+
+bool SpriteBatch::set(int id, const Sprite& sprite) {
+    if (id < 0 || static_cast<size_t>(id) >= getCount()) {
+        return false;
+    }
+
+    sprites_[id] = sprite;
+    markDirty(static_cast<size_t>(id));
+    return true;
+}
+
+void SpriteBatch::clear() {
+    sprites_.clear();
+    vertices_.clear();
+    indices_.clear();
+    dirty_begin_ = dirty_end_ = 0;
+    bounds_x0_ = bounds_y0_ = INFINITY;
+    bounds_x1_ = bounds_y1_ = -INFINITY;
+}
+
+void SpriteBatch::getBounds(float* x0, float* y0, float* x1, float* y1) const {
+    *x0 = bounds_x0_;
+    *y0 = bounds_y0_;
+    *x1 = bounds_x1_;
+    *y1 = bounds_y1_;
+}
+
+void SpriteBatch::markDirty(size_t index) {
+    if (dirty_begin_ == dirty_end_) {
+        dirty_begin_ = index;
+        dirty_end_ = index + 1;
+        return;
+    }
+    dirty_begin_ = std::min(dirty_begin_, index);
+    dirty_end_ = std::max(dirty_end_, index + 1);
+}
+
+const std::vector<SDL_Vertex>& SpriteBatch::buildVertices(const Image& image) {
+    for (size_t i = dirty_begin_; i < dirty_end_; ++i) {
+        writeSprite(image, i);
+    }
+    dirty_begin_ = dirty_end_ = 0;
+    return vertices_;
+}
+
+void SpriteBatch::writeSprite(const Image& image, size_t index) {
+    const Sprite& sprite = sprites_[index];
+    SDL_Vertex* v = &vertices_[index * 4];
+
+    SDL_FRect source = sprite.source;
+    if (source.w <= 0.0f || source.h <= 0.0f) {
+        source = {0.0f, 0.0f, float(image.getWidth()), float(image.getHeight())};
+    }
+
+    // Sprites whose source lies in trimmed-away space keep a degenerate quad so ids stay stable
+    TextureQuad quad;
+    if (!image.mapRegion(source, &quad)) {
+        for (int i = 0; i < 4; ++i) {
+            v[i] = {{0.0f, 0.0f}, {0.0f, 0.0f, 0.0f, 0.0f}, {0.0f, 0.0f}};
+        }
+        return;
+    }
+
+    // Same placement rules as Graphics::draw: scale around the origin, then rotate around (x, y)
+    const float left = (quad.x0 - sprite.ox) * sprite.sx;
+    const float top = (quad.y0 - sprite.oy) * sprite.sy;
+    const float right = (quad.x1 - sprite.ox) * sprite.sx;
+    const float bottom = (quad.y1 - sprite.oy) * sprite.sy;
+
+    const float c = std::cos(sprite.rotation);
+    const float s = std::sin(sprite.rotation);
+    auto place = [&](float px, float py) -> SDL_FPoint {
+        return {sprite.x + px * c - py * s, sprite.y + px * s + py * c};
+    };
+
+    const SDL_FColor color = {sprite.color.r, sprite.color.g, sprite.color.b, sprite.color.a};
+    v[0] = {place(left, top), color, {quad.u0, quad.v0}};
+    v[1] = {place(right, top), color, {quad.u1, quad.v0}};
+    v[2] = {place(right, bottom), color, {quad.u1, quad.v1}};
+    v[3] = {place(left, bottom), color, {quad.u0, quad.v1}};
+
+    for (int i = 0; i < 4; ++i) {
+        bounds_x0_ = std::min(bounds_x0_, v[i].position.x);
+        bounds_y0_ = std::min(bounds_y0_, v[i].position.y);
+        bounds_x1_ = std::max(bounds_x1_, v[i].position.x);
+        bounds_y1_ = std::max(bounds_y1_, v[i].position.y);
+    }
+}
+
+} // namespace tsuki
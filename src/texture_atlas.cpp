@@ -0,0 +1,208 @@
+#include "tsuki/texture_atlas.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+namespace tsuki {
+
+TextureAtlas::~TextureAtlas() {
+    clear();
+}
+
+bool TextureAtlas::insert(SDL_Renderer* renderer, const unsigned char* pixels, int width, int height, int pitch,
+                          Region* region) {
+    if (!renderer || !pixels || width <= 0 || height <= 0 ||
+        width > MAX_IMAGE_SIZE || height > MAX_IMAGE_SIZE) {
+        return false;
+    }
+
+    const int paddedWidth = width + PADDING * 2;
+    const int paddedHeight = height + PADDING * 2;
+
+    // Try the existing pages first, open a new one if none has room
+    int x = 0, y = 0;
+    size_t pageIndex = 0;
+    for (; pageIndex < pages_.size(); ++pageIndex) {
+        if (packSkyline(pages_[pageIndex], paddedWidth, paddedHeight, &x, &y)) {
+            break;
+        }
+    }
+    if (pageIndex == pages_.size()) {
+        if (!createPage(renderer) || !packSkyline(pages_.back(), paddedWidth, paddedHeight, &x, &y)) {
+            return false;
+        }
+    }
+
+    Page& page = pages_[pageIndex];
+
+    // Copy the image with its edge pixels repeated into the padding, so linear
+    // filtering at the border never samples a neighbouring image
+    std::vector<unsigned char> padded(static_cast<size_t>(paddedWidth) * paddedHeight * 4);
+    for (int row = 0; row < paddedHeight; ++row) {
+        int srcRow = std::clamp(row - PADDING, 0, height - 1);
+        const unsigned char* src = pixels + static_cast<size_t>(srcRow) * pitch;
+        unsigned char* dst = padded.data() + static_cast<size_t>(row) * paddedWidth * 4;
+
+        std::memcpy(dst + PADDING * 4, src, static_cast<size_t>(width) * 4);
+        for (int i = 0; i < PADDING; ++i) {
+            std::memcpy(dst + i * 4, src, 4);
+            std::memcpy(dst + (PADDING + width + i) * 4, src + (width - 1) * 4, 4);
+        }
+    }
+
+    SDL_Rect paddedRect = {x, y, paddedWidth, paddedHeight};
+    if (!SDL_UpdateTexture(page.texture, &paddedRect, padded.data(), paddedWidth * 4)) {
+        return false;
+    }
+
+    page.usedPixels += width * height;
+    page.imageCount++;
+
+    region->texture = page.texture;
+    region->page = static_cast<int>(pageIndex);
+    region->rect = {x + PADDING, y + PADDING, width, height};
+    region->pageWidth = PAGE_SIZE;
+    region->pageHeight = PAGE_SIZE;
+    return true;
+}
+
+void TextureAtlas::release(int page, int width, int height) {
+    if (page < 0 || static_cast<size_t>(page) >= pages_.size()) {
+        return;
+    }
+
+    Page& p = pages_[page];
+    p.usedPixels = std::max(0, p.usedPixels - width * height);
+    p.imageCount = std::max(0, p.imageCount - 1);
+
+    // A skyline can't free individual rects, but an empty page can be reused from scratch
+    if (p.imageCount == 0) {
+        p.usedPixels = 0;
+        resetSkyline(p);
+    }
+}
+
+void TextureAtlas::clear() {
+    for (auto& page : pages_) {
+        if (page.texture) {
+            SDL_DestroyTexture(page.texture);
+        }
+    }
+    pages_.clear();
+}
+
+std::vector<TextureAtlas::PageStats> TextureAtlas::getStats() const {
+    std::vector<PageStats> stats;
+    stats.reserve(pages_.size());
+    for (const auto& page : pages_) {
+        PageStats s;
+        s.width = PAGE_SIZE;
+        s.height = PAGE_SIZE;
+        s.usedPixels = page.usedPixels;
+        s.imageCount = page.imageCount;
+        s.usage = static_cast<float>(page.usedPixels) / (PAGE_SIZE * PAGE_SIZE);
+        stats.push_back(s);
+    }
+    return stats;
+}
+
+bool TextureAtlas::createPage(SDL_Renderer* renderer) {
+    Page page;
+    page.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC,
+                                     PAGE_SIZE, PAGE_SIZE);
+    if (!page.texture) {
+        return false;
+    }
+    SDL_SetTextureBlendMode(page.texture, SDL_BLENDMODE_BLEND);
+
+    std::vector<unsigned char> blank(static_cast<size_t>(PAGE_SIZE) * PAGE_SIZE * 4, 0);
+    SDL_UpdateTexture(page.texture, nullptr, blank.data(), PAGE_SIZE * 4);
+
+    resetSkyline(page);
+    pages_.push_back(std::move(page));
+    return true;
+}
+
+void TextureAtlas::resetSkyline(Page& page) {
+    page.skyline.clear();
+    page.skyline.push_back({0, 0, PAGE_SIZE});
+}
+
+// Returns the y at which a width x height rect fits when its left edge sits on node `index`, or -1
+int TextureAtlas::fitSkyline(const Page& page, size_t index, int width, int height) {
+    int x = page.skyline[index].x;
+    if (x + width > PAGE_SIZE) {
+        return -1;
+    }
+
+    int y = page.skyline[index].y;
+    int widthLeft = width;
+    for (size_t i = index; widthLeft > 0 && i < page.skyline.size(); ++i) {
+        y = std::max(y, page.skyline[i].y);
+        if (y + height > PAGE_SIZE) {
+            return -1;
+        }
+        widthLeft -= page.skyline[i].width;
+    }
+    return y;
+}
+
+// Bottom-left skyline packing: place at the lowest top edge, preferring narrower nodes on ties
+bool TextureAtlas::packSkyline(Page& page, int width, int height, int* x, int* y) {
+    int bestTop = INT_MAX;
+    int bestWidth = INT_MAX;
+    size_t bestIndex = page.skyline.size();
+
+    for (size_t i = 0; i < page.skyline.size(); ++i) {
+        int fitY = fitSkyline(page, i, width, height);
+        if (fitY < 0) {
+            continue;
+        }
+        int top = fitY + height;
+        if (top < bestTop || (top == bestTop && page.skyline[i].width < bestWidth)) {
+            bestTop = top;
+            bestWidth = page.skyline[i].width;
+            bestIndex = i;
+            *x = page.skyline[i].x;
+            *y = fitY;
+        }
+    }
+
+    if (bestIndex == page.skyline.size()) {
+        return false;
+    }
+
+    // Raise the skyline under the new rect
+    page.skyline.insert(page.skyline.begin() + bestIndex, {*x, *y + height, width});
+
+    for (size_t i = bestIndex + 1; i < page.skyline.size();) {
+        SkylineNode& prev = page.skyline[i - 1];
+        SkylineNode& node = page.skyline[i];
+        if (node.x >= prev.x + prev.width) {
+            break;
+        }
+
+        int shrink = prev.x + prev.width - node.x;
+        node.x += shrink;
+        node.width -= shrink;
+        if (node.width <= 0) {
+            page.skyline.erase(page.skyline.begin() + i);
+        } else {
+            break;
+        }
+    }
+
+    // Merge neighbours at the same height
+    for (size_t i = 0; i + 1 < page.skyline.size();) {
+        if (page.skyline[i].y == page.skyline[i + 1].y) {
+            page.skyline[i].width += page.skyline[i + 1].width;
+            page.skyline.erase(page.skyline.begin() + i + 1);
+        } else {
+            ++i;
+        }
+    }
+
+    return true;
+}
+
+} // namespace tsuki
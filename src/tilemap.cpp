@@ -0,0 +1,114 @@
+#include "tsuki/tilemap.hpp"
+#include <algorithm>
+
+namespace tsuki {
+
+Tilemap::Tilemap(ImageHandle tileset, int tileWidth, int tileHeight, int width, int height,
+                 int layers, int chunkSize)
+    : tileset_(tileset),
+      tile_width_(std::max(1, tileWidth)),
+      tile_height_(std::max(1, tileHeight)),
+      width_(std::max(0, width)),
+      height_(std::max(0, height)),
+      layers_(std::max(1, layers)),
+      chunk_size_(std::max(1, chunkSize)) {
+    chunks_x_ = (width_ + chunk_size_ - 1) / chunk_size_;
+    chunks_y_ = (height_ + chunk_size_ - 1) / chunk_size_;
+
+    tiles_.assign(static_cast<size_t>(layers_) * width_ * height_, EMPTY_TILE);
+    chunks_.resize(static_cast<size_t>(layers_) * chunks_x_ * chunks_y_);
+}
+
+void Tilemap::setTile(int layer, int x, int y, int tile) {
+    if (!inBounds(layer, x, y)) {
+        return;
+    }
+
+    int& slot = tiles_[(static_cast<size_t>(layer) * height_ + y) * width_ + x];
+    if (slot == tile) {
+        return;
+    }
+
+    slot = tile;
+    chunkAt(layer, x / chunk_size_, y / chunk_size_).dirty = true;
+}
+
+int Tilemap::getTile(int layer, int x, int y) const {
+    if (!inBounds(layer, x, y)) {
+        return EMPTY_TILE;
+    }
+    return tiles_[(static_cast<size_t>(layer) * height_ + y) * width_ + x];
+}
+
+void Tilemap::fill(int layer, int tile) {
+    if (layer < 0 || layer >= layers_) {
+        return;
+    }
+
+    auto first = tiles_.begin() + static_cast<size_t>(layer) * width_ * height_;
+    std::fill(first, first + static_cast<size_t>(width_) * height_, tile);
+
+    for (int cy = 0; cy < chunks_y_; ++cy) {
+        for (int cx = 0; cx < chunks_x_; ++cx) {
+            chunkAt(layer, cx, cy).dirty = true;
+        }
+    }
+}
+
+void Tilemap::rebuildChunk(const Image& tileset, int layer, int cx, int cy) {
+    Chunk& chunk = chunkAt(layer, cx, cy);
+    chunk.vertices.clear();
+    chunk.indices.clear();
+    chunk.dirty = false;
+
+    if (!tileset.isValid()) {
+        return;
+    }
+
+    const int columns = std::max(1, tileset.getWidth() / tile_width_);
+    const int startX = cx * chunk_size_;
+    const int startY = cy * chunk_size_;
+    const int endX = std::min(width_, startX + chunk_size_);
+    const int endY = std::min(height_, startY + chunk_size_);
+    const SDL_FColor white = {1.0f, 1.0f, 1.0f, 1.0f};
+
+    for (int y = startY; y < endY; ++y) {
+        for (int x = startX; x < endX; ++x) {
+            int tile = tiles_[(static_cast<size_t>(layer) * height_ + y) * width_ + x];
+            if (tile == EMPTY_TILE) {
+                continue;
+            }
+
+            const int cell = tile - 1;
+            const SDL_FRect source = {
+                static_cast<float>((cell % columns) * tile_width_),
+                static_cast<float>((cell / columns) * tile_height_),
+                static_cast<float>(tile_width_),
+                static_cast<float>(tile_height_)
+            };
+
+            TextureQuad quad;
+            if (!tileset.mapRegion(source, &quad)) {
+                continue;
+            }
+
+            const float px = static_cast<float>(x * tile_width_);
+            const float py = static_cast<float>(y * tile_height_);
+            const int base = static_cast<int>(chunk.vertices.size());
+
+            chunk.vertices.push_back({{px + quad.x0, py + quad.y0}, white, {quad.u0, quad.v0}});
+            chunk.vertices.push_back({{px + quad.x1, py + quad.y0}, white, {quad.u1, quad.v0}});
+            chunk.vertices.push_back({{px + quad.x1, py + quad.y1}, white, {quad.u1, quad.v1}});
+            chunk.vertices.push_back({{px + quad.x0, py + quad.y1}, white, {quad.u0, quad.v1}});
+
+            chunk.indices.push_back(base);
+            chunk.indices.push_back(base + 1);
+            chunk.indices.push_back(base + 2);
+            chunk.indices.push_back(base);
+            chunk.indices.push_back(base + 2);
+            chunk.indices.push_back(base + 3);
+        }
+    }
+}
+
+} // namespace tsuki
@@ -8,6 +8,10 @@ Window::~Window() {
 }
 
 bool Window::init(const WindowSettings& settings) {
+    if (settings.headless) {
+        return initHeadless(settings);
+    }
+
     Uint32 window_flags = SDL_WINDOW_OPENGL;
     if (settings.resizable) {
         window_flags |= SDL_WINDOW_RESIZABLE;
@@ -38,11 +42,47 @@ bool Window::init(const WindowSettings& settings) {
     return true;
 }
 
+bool Window::initHeadless(const WindowSettings& settings) {
+    headless_ = true;
+
+    // A hidden window keeps size queries and events working; the software renderer needs no GPU
+    window_ = SDL_CreateWindow(settings.title.c_str(), settings.width, settings.height, SDL_WINDOW_HIDDEN);
+    if (window_) {
+        renderer_ = SDL_CreateRenderer(window_, SDL_SOFTWARE_RENDERER);
+        if (renderer_) {
+            return true;
+        }
+        SDL_DestroyWindow(window_);
+        window_ = nullptr;
+    }
+
+    // Some video drivers cannot back a window at all, so render into a plain surface instead
+    surface_ = SDL_CreateSurface(settings.width, settings.height, SDL_PIXELFORMAT_ARGB8888);
+    if (!surface_) {
+        std::cerr << "Failed to create headless surface: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    renderer_ = SDL_CreateSoftwareRenderer(surface_);
+    if (!renderer_) {
+        std::cerr << "Failed to create headless renderer: " << SDL_GetError() << std::endl;
+        SDL_DestroySurface(surface_);
+        surface_ = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
 void Window::shutdown() {
     if (renderer_) {
         SDL_DestroyRenderer(renderer_);
         renderer_ = nullptr;
     }
+    if (surface_) {
+        SDL_DestroySurface(surface_);
+        surface_ = nullptr;
+    }
     if (window_) {
         SDL_DestroyWindow(window_);
         window_ = nullptr;
@@ -75,6 +115,9 @@ int Window::getWidth() const {
         SDL_GetWindowSize(window_, &width, nullptr);
         return width;
     }
+    if (surface_) {
+        return surface_->w;
+    }
     return 0;
 }
 
@@ -84,6 +127,9 @@ int Window::getHeight() const {
         SDL_GetWindowSize(window_, nullptr, &height);
         return height;
     }
+    if (surface_) {
+        return surface_->h;
+    }
     return 0;
 }
 